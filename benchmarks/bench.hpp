@@ -0,0 +1,202 @@
+#pragma once
+
+// Minimal benchmark harness. Each benchmark executable includes this header once.
+// Usage: <name>_bench [--format=text|csv|json] [--filter=substring]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#define MCO_BENCH_PERF 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifndef MCO_VERSION
+#define MCO_VERSION "unknown"
+#endif
+
+namespace bench
+{
+
+// Allocations made by every thread of the process, counted by the operator new replacement below,
+// so benchmarks doing their work on worker threads are measured as well
+inline std::atomic<std::size_t> s_allocations {0};
+
+enum class Format { text, csv, json };
+
+struct Options
+{
+    Format m_format {Format::text};
+    std::string m_filter;
+};
+
+inline Options& options()
+{
+    static Options o;
+    return o;
+}
+
+inline void init(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--format=csv"))
+            options().m_format = Format::csv;
+        else if (!std::strcmp(argv[i], "--format=json"))
+            options().m_format = Format::json;
+        else if (!std::strncmp(argv[i], "--filter=", 9))
+            options().m_filter = argv[i] + 9;
+    }
+
+    if (options().m_format == Format::csv)
+        std::printf("version,benchmark,ns_per_iter,allocations_per_iter,instructions_per_iter,cache_misses_per_iter\n");
+    else if (options().m_format == Format::text)
+        std::printf("%-48s %14s %10s %14s %14s\n", "benchmark", "ns/iter", "allocs", "instructions", "cache-misses");
+}
+
+enum class Event { instructions, cacheMisses };
+
+// Hardware counter of the calling thread and of the threads it creates while the counter exists,
+// unavailable (-1) when perf_event_open is not permitted
+struct PerfCounter
+{
+#ifdef MCO_BENCH_PERF
+    explicit PerfCounter(Event event)
+    {
+        auto config = event == Event::instructions ? PERF_COUNT_HW_INSTRUCTIONS : PERF_COUNT_HW_CACHE_MISSES;
+        perf_event_attr attr {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1; // worker threads are counted once they exit
+        m_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    ~PerfCounter() { if (m_fd >= 0) close(m_fd); }
+
+    void start() { if (m_fd >= 0) { ioctl(m_fd, PERF_EVENT_IOC_RESET, 0); ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0); } }
+    void stop() { if (m_fd >= 0) ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0); }
+
+    long long value() const
+    {
+        long long v = -1;
+        if (m_fd < 0 || read(m_fd, &v, sizeof(v)) != sizeof(v))
+            return -1;
+        return v;
+    }
+
+    int m_fd {-1};
+#else
+    explicit PerfCounter(Event) {}
+    void start() {}
+    void stop() {}
+    long long value() const { return -1; }
+#endif
+};
+
+// Keeps the compiler from discarding a value whose computation is being measured
+template<class T>
+void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void report(const char* name, double ns, double allocations, double instructions, double cacheMisses)
+{
+    switch (options().m_format)
+    {
+    case Format::text:
+        std::printf("%-48s %14.1f %10.1f %14.0f %14.0f\n", name, ns, allocations, instructions, cacheMisses);
+        break;
+    case Format::csv:
+        std::printf("%s,%s,%.1f,%.2f,%.0f,%.0f\n", MCO_VERSION, name, ns, allocations, instructions, cacheMisses);
+        break;
+    case Format::json:
+        std::printf("{\"version\": \"%s\", \"benchmark\": \"%s\", \"ns_per_iter\": %.1f, \"allocations_per_iter\": %.2f, "
+                    "\"instructions_per_iter\": %.0f, \"cache_misses_per_iter\": %.0f}\n",
+                    MCO_VERSION, name, ns, allocations, instructions, cacheMisses);
+        break;
+    }
+    std::fflush(stdout);
+}
+
+// Best of several repetitions, reported per call of fn. Counters are averaged over every repetition,
+// they are reported as -1 when unavailable.
+template<class Fn>
+double run(const char* name, std::size_t iterations, Fn&& fn)
+{
+    if (!options().m_filter.empty() && !std::strstr(name, options().m_filter.c_str()))
+        return 0;
+
+    using Clock = std::chrono::steady_clock;
+    constexpr int reps = 7;
+    PerfCounter instructions(Event::instructions);
+    PerfCounter cacheMisses(Event::cacheMisses);
+
+    double best = 1e300;
+    fn(); // warm up the allocator and the page tables
+    auto allocations = s_allocations.load(std::memory_order_relaxed);
+    instructions.start();
+    cacheMisses.start();
+    for (int rep = 0; rep < reps; ++rep)
+    {
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+            fn();
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        best = std::min(best, elapsed.count()/iterations);
+    }
+    instructions.stop();
+    cacheMisses.stop();
+
+    double total = double(reps)*iterations;
+    auto perIteration = [&] (long long v) { return v < 0 ? -1.0 : v/total; };
+    report(name, best, (s_allocations.load(std::memory_order_relaxed) - allocations)/total, perIteration(instructions.value()), perIteration(cacheMisses.value()));
+    return best;
+}
+
+}
+
+// Counts allocations, the aligned overloads of the standard library go through malloc/free as well
+void* operator new(std::size_t numBytes)
+{
+    bench::s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(numBytes ? numBytes : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t numBytes, std::align_val_t align)
+{
+    bench::s_allocations.fetch_add(1, std::memory_order_relaxed);
+    auto a = std::max(std::size_t(align), sizeof(void*));
+    if (void* p = std::aligned_alloc(a, (numBytes + a - 1)/a*a))
+        return p;
+    throw std::bad_alloc();
+}
+
+// GCC can't see that these replace the operator new paired with them
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
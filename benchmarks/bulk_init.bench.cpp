@@ -0,0 +1,69 @@
+#include "bench.hpp"
+
+#include <mco.hpp>
+
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+// Compares the bulk initialization paths of make_contiguous_objects with the equivalent
+// hand-written allocate + memset/fill/memcpy
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    constexpr std::size_t n = 100000;
+    constexpr std::size_t iterations = 2000;
+
+    std::vector<int> src(n);
+    std::iota(src.begin(), src.end(), 0);
+
+    bench::run("bulk_init/zero/hand_written", iterations, [&] {
+        auto p = std::make_unique<int[]>(n);
+        bench::doNotOptimize(p[n/2]);
+    });
+    bench::run("bulk_init/zero/mco", iterations, [&] {
+        auto t = xtd::make_contiguous_objects<int>(n);
+        bench::doNotOptimize(std::get<0>(t).begin()[n/2]);
+        xtd::destroy_contiguous_objects(t);
+    });
+
+    bench::run("bulk_init/fill/hand_written", iterations, [&] {
+        std::unique_ptr<int[]> p(new int[n]);
+        std::fill_n(p.get(), n, 7);
+        bench::doNotOptimize(p[n/2]);
+    });
+    bench::run("bulk_init/fill/mco", iterations, [&] {
+        auto t = xtd::make_contiguous_objects<int>(xtd::arg(xtd::ctor, n, 7));
+        bench::doNotOptimize(std::get<0>(t).begin()[n/2]);
+        xtd::destroy_contiguous_objects(t);
+    });
+
+    bench::run("bulk_init/copy/hand_written", iterations, [&] {
+        std::unique_ptr<int[]> p(new int[n]);
+        std::memcpy(p.get(), src.data(), n*sizeof(int));
+        bench::doNotOptimize(p[n/2]);
+    });
+    bench::run("bulk_init/copy/mco", iterations, [&] {
+        auto t = xtd::make_contiguous_objects<int>(xtd::arg(xtd::input_iterator, n, src.cbegin()));
+        bench::doNotOptimize(std::get<0>(t).begin()[n/2]);
+        xtd::destroy_contiguous_objects(t);
+    });
+
+    // Several sections in a single block against one allocation per array
+    bench::run("bulk_init/three_sections/hand_written", iterations, [&] {
+        auto a = std::make_unique<double[]>(n);
+        std::unique_ptr<int[]> b(new int[n]);
+        std::memcpy(b.get(), src.data(), n*sizeof(int));
+        std::unique_ptr<char[]> c(new char[n]);
+        std::memset(c.get(), 'x', n);
+        bench::doNotOptimize(a[n/2] + b[n/2] + c[n/2]);
+    });
+    bench::run("bulk_init/three_sections/mco", iterations, [&] {
+        auto t = xtd::make_contiguous_objects<double, int, char>(
+            n, xtd::arg(xtd::input_iterator, n, src.data()), xtd::arg(xtd::ctor, n, 'x'));
+        bench::doNotOptimize(std::get<0>(t).begin()[n/2] + std::get<1>(t).begin()[n/2] + std::get<2>(t).begin()[n/2]);
+        xtd::destroy_contiguous_objects(t);
+    });
+}
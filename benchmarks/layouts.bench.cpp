@@ -0,0 +1,204 @@
+#include "bench.hpp"
+
+#include <mco.hpp>
+#include <mco_allocators.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// make_contiguous_objects against the usual alternatives for a table of n entities with three fields:
+// one std::vector per field, a hand-rolled blob and one shared array per field
+
+namespace
+{
+
+constexpr std::size_t s_tableSize = 10000;
+constexpr std::size_t s_numNodes = 2000;
+constexpr std::size_t s_edgesPerNode = 16;
+
+template<class T>
+std::shared_ptr<T[]> makeSharedArray(std::size_t n)
+{
+#if __cpp_lib_shared_ptr_arrays >= 201707L
+    return std::make_shared<T[]>(n);
+#else
+    return std::shared_ptr<T[]>(new T[n]());
+#endif
+}
+
+struct VectorTable
+{
+    VectorTable(std::size_t n) : m_ids(n), m_values(n), m_flags(n) {}
+    std::vector<int> m_ids;
+    std::vector<double> m_values;
+    std::vector<char> m_flags;
+};
+
+struct SharedTable
+{
+    SharedTable(std::size_t n) : m_ids(makeSharedArray<int>(n)), m_values(makeSharedArray<double>(n)), m_flags(makeSharedArray<char>(n)) {}
+    std::shared_ptr<int[]> m_ids;
+    std::shared_ptr<double[]> m_values;
+    std::shared_ptr<char[]> m_flags;
+};
+
+// What one would write without the library: offsets computed by hand, one malloc
+struct BlobTable
+{
+    BlobTable(std::size_t n) : m_size(n)
+    {
+        m_blob = (std::byte*)std::malloc(n*sizeof(double) + n*sizeof(int) + n);
+        std::memset(m_blob, 0, n*sizeof(double) + n*sizeof(int) + n);
+    }
+    ~BlobTable() { std::free(m_blob); }
+    double* values() const { return (double*)m_blob; }
+    int* ids() const { return (int*)(m_blob + m_size*sizeof(double)); }
+    char* flags() const { return (char*)(m_blob + m_size*(sizeof(double) + sizeof(int))); }
+    std::byte* m_blob;
+    std::size_t m_size;
+};
+
+double traverse(const int* ids, const double* values, const char* flags, std::size_t n)
+{
+    double sum = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        sum += flags[i] ? values[i] : ids[i];
+    return sum;
+}
+
+// Graph with a variable number of edges per node, the vector-of-vectors case
+struct VectorNode
+{
+    int m_id;
+    std::vector<int> m_edges;
+    std::vector<float> m_weights;
+};
+
+using NodeLayout = std::tuple<xtd::span<int, 1>, xtd::span<int>, xtd::span<float>>;
+
+template<class Fn>
+void inThreads(unsigned numThreads, Fn&& fn)
+{
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < numThreads; ++i)
+        threads.emplace_back(fn);
+    for (auto& t : threads)
+        t.join();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+    const auto n = s_tableSize;
+
+    // Allocation and teardown of one table
+    bench::run("table/alloc/mco", 2000, [&] {
+        auto t = xtd::make_contiguous_objects<int, double, char>(n, n, n);
+        bench::doNotOptimize(std::get<0>(t).begin());
+        xtd::destroy_contiguous_objects(t);
+    });
+    bench::run("table/alloc/vector_per_field", 2000, [&] {
+        VectorTable t(n);
+        bench::doNotOptimize(t.m_ids.data());
+    });
+    bench::run("table/alloc/blob", 2000, [&] {
+        BlobTable t(n);
+        bench::doNotOptimize(t.m_blob);
+    });
+    bench::run("table/alloc/shared_array_per_field", 2000, [&] {
+        SharedTable t(n);
+        bench::doNotOptimize(t.m_ids.get());
+    });
+
+    // Traversal of an existing table
+    {
+        auto mco = xtd::make_contiguous_objects<int, double, char>(n, n, xtd::arg(xtd::ctor, n, 1));
+        VectorTable vec(n);
+        BlobTable blob(n);
+        SharedTable shared(n);
+
+        bench::run("table/traverse/mco", 5000, [&] {
+            bench::doNotOptimize(traverse(std::get<0>(mco).begin(), std::get<1>(mco).begin(), std::get<2>(mco).begin(), n));
+        });
+        bench::run("table/traverse/vector_per_field", 5000, [&] {
+            bench::doNotOptimize(traverse(vec.m_ids.data(), vec.m_values.data(), vec.m_flags.data(), n));
+        });
+        bench::run("table/traverse/blob", 5000, [&] {
+            bench::doNotOptimize(traverse(blob.ids(), blob.values(), blob.flags(), n));
+        });
+        bench::run("table/traverse/shared_array_per_field", 5000, [&] {
+            bench::doNotOptimize(traverse(shared.m_ids.get(), shared.m_values.get(), shared.m_flags.get(), n));
+        });
+
+        xtd::destroy_contiguous_objects(mco);
+    }
+
+    // Many small objects: build, traverse and tear down a graph
+    bench::run("graph/build_traverse_teardown/mco", 50, [&] {
+        std::vector<NodeLayout> nodes;
+        nodes.reserve(s_numNodes);
+        for (std::size_t i = 0; i < s_numNodes; ++i)
+            nodes.push_back(xtd::make_contiguous_objects<int[1], int, float>(
+                xtd::arg(xtd::ctor, 1, int(i)), xtd::arg(xtd::ctor, s_edgesPerNode, 1), xtd::arg(xtd::ctor, s_edgesPerNode, 0.5f)));
+        double sum = 0;
+        for (auto& node : nodes)
+            for (std::size_t e = 0; e < s_edgesPerNode; ++e)
+                sum += std::get<1>(node).begin()[e]*std::get<2>(node).begin()[e];
+        bench::doNotOptimize(sum);
+        for (auto& node : nodes)
+            xtd::destroy_contiguous_objects(node);
+    });
+    bench::run("graph/build_traverse_teardown/vector_of_vectors", 50, [&] {
+        std::vector<VectorNode> nodes;
+        nodes.reserve(s_numNodes);
+        for (std::size_t i = 0; i < s_numNodes; ++i)
+            nodes.push_back({int(i), std::vector<int>(s_edgesPerNode, 1), std::vector<float>(s_edgesPerNode, 0.5f)});
+        double sum = 0;
+        for (auto& node : nodes)
+            for (std::size_t e = 0; e < s_edgesPerNode; ++e)
+                sum += node.m_edges[e]*node.m_weights[e];
+        bench::doNotOptimize(sum);
+    });
+
+    // Allocation throughput with every thread allocating small layouts
+    constexpr std::size_t opsPerThread = 20000;
+    for (unsigned threads = 1; threads <= std::max(1u, std::thread::hardware_concurrency()); threads *= 2)
+    {
+        auto suffix = "/" + std::to_string(threads) + "_threads";
+        bench::run(("scaling/mco" + suffix).c_str(), 3, [&] {
+            inThreads(threads, [] {
+                for (std::size_t i = 0; i < opsPerThread; ++i)
+                {
+                    auto t = xtd::make_contiguous_objects<int, double, char>(8, 8, 8);
+                    bench::doNotOptimize(std::get<0>(t).begin());
+                    xtd::destroy_contiguous_objects(t);
+                }
+            });
+        });
+        bench::run(("scaling/mco_thread_pool_allocator" + suffix).c_str(), 3, [&] {
+            inThreads(threads, [] {
+                xtd::thread_pool_allocator<char> alloc;
+                for (std::size_t i = 0; i < opsPerThread; ++i)
+                {
+                    auto t = xtd::make_contiguous_objects<int, double, char>(alloc, 8, 8, 8);
+                    bench::doNotOptimize(std::get<0>(t).begin());
+                    xtd::destroy_contiguous_objects(alloc, t);
+                }
+            });
+        });
+        bench::run(("scaling/vector_per_field" + suffix).c_str(), 3, [&] {
+            inThreads(threads, [] {
+                for (std::size_t i = 0; i < opsPerThread; ++i)
+                {
+                    VectorTable t(8);
+                    bench::doNotOptimize(t.m_ids.data());
+                }
+            });
+        });
+    }
+}
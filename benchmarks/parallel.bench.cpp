@@ -0,0 +1,48 @@
+#include "bench.hpp"
+
+#include <mco_parallel.hpp>
+
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Construction of large sections on one thread against the parallel overload
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    constexpr std::size_t n = std::size_t(1) << 24;
+    constexpr std::size_t iterations = 5;
+
+    std::vector<float> src(n);
+    std::iota(src.begin(), src.end(), 0.f);
+    auto functor = [] { return std::sqrt(2.0); };
+
+    bench::run("parallel/functor/sequential", iterations, [&] {
+        auto t = xtd::make_contiguous_objects<double>(xtd::arg(xtd::functor, n, functor));
+        bench::doNotOptimize(std::get<0>(t).begin()[n/2]);
+        xtd::destroy_contiguous_objects(t);
+    });
+    bench::run("parallel/copy/sequential", iterations, [&] {
+        auto t = xtd::make_contiguous_objects<float>(xtd::arg(xtd::input_iterator, n, src.cbegin()));
+        bench::doNotOptimize(std::get<0>(t).begin()[n/2]);
+        xtd::destroy_contiguous_objects(t);
+    });
+
+    for (unsigned threads = 2; threads <= std::max(2u, std::thread::hardware_concurrency()); threads *= 2)
+    {
+        auto suffix = "/" + std::to_string(threads) + "_threads";
+        bench::run(("parallel/functor" + suffix).c_str(), iterations, [&] {
+            auto t = xtd::make_contiguous_objects<double>(xtd::parallel_t{threads}, xtd::arg(xtd::functor, n, functor));
+            bench::doNotOptimize(std::get<0>(t).begin()[n/2]);
+            xtd::destroy_contiguous_objects(t);
+        });
+        bench::run(("parallel/copy" + suffix).c_str(), iterations, [&] {
+            auto t = xtd::make_contiguous_objects<float>(xtd::parallel_t{threads}, xtd::arg(xtd::input_iterator, n, src.cbegin()));
+            bench::doNotOptimize(std::get<0>(t).begin()[n/2]);
+            xtd::destroy_contiguous_objects(t);
+        });
+    }
+}
@@ -0,0 +1,65 @@
+#include "bench.hpp"
+
+#include <mco_pool.hpp>
+
+#include <vector>
+
+// Nodes of the same shape made and destroyed by the global heap against a contiguous_object_pool
+struct Header
+{
+    int m_numKeys;
+    int m_level;
+};
+
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    constexpr std::size_t numNodes = 10000;
+    constexpr std::size_t iterations = 20;
+    using Layout = std::tuple<xtd::span<Header, 1>, xtd::span<long>, xtd::span<double>>;
+    std::vector<Layout> nodes(numNodes);
+
+    bench::run("pool/make_destroy/make_contiguous_objects", iterations, [&] {
+        for (auto& n : nodes)
+            n = xtd::make_contiguous_objects<Header[1], long[], double[]>(1, 8, 8);
+        for (auto& n : nodes)
+            xtd::destroy_contiguous_objects(n);
+    });
+
+    xtd::contiguous_object_pool<Header[1], long[], double[]> pool(8, 8);
+    bench::run("pool/make_destroy/pool", iterations, [&] {
+        for (auto& n : nodes)
+            n = pool.make(8, 8);
+        for (auto& n : nodes)
+            pool.destroy(n);
+    });
+
+    xtd::contiguous_object_pool<Header[1], long[], double[]> cached(xtd::pool_options{256, 4}, 8, 8);
+    bench::run("pool/make_destroy/pool_thread_caches", iterations, [&] {
+        for (auto& n : nodes)
+            n = cached.make(8, 8);
+        for (auto& n : nodes)
+            cached.destroy(n);
+    });
+
+    // Walking every node once they are built
+    auto traverse = [&] {
+        long total = 0;
+        for (auto& n : nodes)
+            total += std::get<1>(n).begin()[7];
+        bench::doNotOptimize(total);
+    };
+
+    for (auto& n : nodes)
+        n = xtd::make_contiguous_objects<Header[1], long[], double[]>(1, 8, 8);
+    bench::run("pool/traverse/make_contiguous_objects", iterations, traverse);
+    for (auto& n : nodes)
+        xtd::destroy_contiguous_objects(n);
+
+    for (auto& n : nodes)
+        n = pool.make(8, 8);
+    bench::run("pool/traverse/pool", iterations, traverse);
+    for (auto& n : nodes)
+        pool.destroy(n);
+}
@@ -0,0 +1,87 @@
+#include "bench.hpp"
+
+#include <mco_shared_array.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+template<class T>
+std::shared_ptr<T[]> makeSharedPtrArray(std::size_t n)
+{
+#if defined(__cpp_lib_shared_ptr_arrays) && __cpp_lib_shared_ptr_arrays >= 201707L
+    return std::make_shared<T[]>(n);
+#else
+    return std::shared_ptr<T[]>(new T[n]());
+#endif
+}
+
+// Every thread copies and drops a handle to the same array. The counters include the worker threads:
+// copies allocate nothing, the allocations reported are the thread vector and one per thread started.
+template<class Handle>
+void contend(const Handle& h, unsigned numThreads, std::size_t numCopies)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (unsigned t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&] {
+            for (std::size_t i = 0; i < numCopies; ++i)
+            {
+                Handle copy = h;
+                bench::doNotOptimize(copy);
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+}
+
+// xtd::shared_array against std::shared_ptr<T[]>
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    constexpr std::size_t n = 64;
+
+    bench::run("shared_array/make_destroy/mco", 100000, [&] {
+        auto a = xtd::make_shared_array<double>(n);
+        bench::doNotOptimize(a.data());
+    });
+    bench::run("shared_array/make_destroy/shared_ptr", 100000, [&] {
+        auto a = makeSharedPtrArray<double>(n);
+        bench::doNotOptimize(a.get());
+    });
+    bench::run("shared_array/make_destroy_for_overwrite/mco", 100000, [&] {
+        auto a = xtd::make_shared_array_for_overwrite<double>(n);
+        bench::doNotOptimize(a.data());
+    });
+    bench::run("shared_array/make_destroy_strings/mco", 10000, [&] {
+        auto a = xtd::make_shared_array<std::string>(n);
+        bench::doNotOptimize(a.data());
+    });
+    bench::run("shared_array/make_destroy_strings/shared_ptr", 10000, [&] {
+        auto a = makeSharedPtrArray<std::string>(n);
+        bench::doNotOptimize(a.get());
+    });
+
+    auto mco = xtd::make_shared_array<double>(n);
+    auto sp = makeSharedPtrArray<double>(n);
+    bench::run("shared_array/copy/mco", 1000000, [&] {
+        auto copy = mco;
+        bench::doNotOptimize(copy);
+    });
+    bench::run("shared_array/copy/shared_ptr", 1000000, [&] {
+        auto copy = sp;
+        bench::doNotOptimize(copy);
+    });
+
+    constexpr std::size_t numCopies = 100000;
+    for (unsigned threads = 1; threads <= std::max(2u, std::thread::hardware_concurrency()); threads *= 2)
+    {
+        auto suffix = "/" + std::to_string(threads) + "_threads";
+        bench::run(("shared_array/contention" + suffix + "/mco").c_str(), 1, [&] { contend(mco, threads, numCopies); });
+        bench::run(("shared_array/contention" + suffix + "/shared_ptr").c_str(), 1, [&] { contend(sp, threads, numCopies); });
+    }
+}
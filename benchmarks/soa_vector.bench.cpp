@@ -0,0 +1,82 @@
+#include "bench.hpp"
+
+#include <mco_soa_vector.hpp>
+
+#include <array>
+#include <vector>
+
+// Scanning two fields of a wide record: array of structs, one std::vector per field and soa_vector
+struct Record
+{
+    double m_price;
+    float m_quantity;
+    int m_id;
+    char m_name[48];
+};
+
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    constexpr std::size_t n = std::size_t(1) << 20;
+    constexpr std::size_t iterations = 20;
+
+    std::vector<Record> aos;
+    std::vector<double> prices;
+    std::vector<float> quantities;
+    std::vector<int> ids;
+    std::vector<std::array<char, 48>> names;
+    xtd::soa_vector<xtd::aligned_column<double, 64>, xtd::aligned_column<float, 64>, int, std::array<char, 48>> soa;
+
+    bench::run("soa_vector/push_back/aos", 1, [&] {
+        std::vector<Record>().swap(aos);
+        for (std::size_t i = 0; i < n; ++i)
+            aos.push_back(Record{double(i), 1.f, int(i), {}});
+    });
+    bench::run("soa_vector/push_back/vector_per_field", 1, [&] {
+        std::vector<double>().swap(prices);
+        std::vector<float>().swap(quantities);
+        std::vector<int>().swap(ids);
+        std::vector<std::array<char, 48>>().swap(names);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            prices.push_back(double(i));
+            quantities.push_back(1.f);
+            ids.push_back(int(i));
+            names.push_back({});
+        }
+    });
+    bench::run("soa_vector/push_back/mco", 1, [&] {
+        soa = {};
+        for (std::size_t i = 0; i < n; ++i)
+            soa.push_back(double(i), 1.f, int(i), {});
+    });
+
+    bench::run("soa_vector/scan/aos", iterations, [&] {
+        double total = 0;
+        for (auto& r : aos)
+            total += r.m_price*r.m_quantity;
+        bench::doNotOptimize(total);
+    });
+    bench::run("soa_vector/scan/vector_per_field", iterations, [&] {
+        double total = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            total += prices[i]*quantities[i];
+        bench::doNotOptimize(total);
+    });
+    bench::run("soa_vector/scan/mco", iterations, [&] {
+        auto p = soa.column<0>().begin();
+        auto q = soa.column<1>().begin();
+        auto size = soa.size();
+        double total = 0;
+        for (std::size_t i = 0; i < size; ++i)
+            total += p[i]*q[i];
+        bench::doNotOptimize(total);
+    });
+    bench::run("soa_vector/scan_zip/mco", iterations, [&] {
+        double total = 0;
+        for (auto [p, q, id, name] : soa)
+            total += p*q;
+        bench::doNotOptimize(total);
+    });
+}
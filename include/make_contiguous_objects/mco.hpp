@@ -1,8 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <string>
+#include <type_traits>
+
+#ifdef MCO_INSTRUMENTATION
+#include <chrono>
+#include <typeinfo>
+#endif
 
 namespace xtd
 {
 
+#ifdef MCO_INSTRUMENTATION
+// Called by the library when compiled with MCO_INSTRUMENTATION, see mco_stats.hpp for a collector.
+// Hooks are read without synchronization: install them before making any layout.
+// Signatures are the std::tuple of spans of the layout.
+// contiguous_object_pool reports every instance as a layout, constructed and destroyed, and its slabs as blocks.
+// soa_vector only reports its blocks and their layouts: rows are constructed and destroyed one at a time, not timed.
+struct instrumentation_hooks
+{
+    // Element bytes and padding bytes of a layout being placed
+    void (*m_onLayout)(const std::type_info& signature, std::size_t elementBytes, std::size_t paddingBytes) {nullptr};
+    void (*m_onConstruct)(const std::type_info& signature, std::chrono::nanoseconds elapsed) {nullptr};
+    void (*m_onDestroy)(const std::type_info& signature, std::chrono::nanoseconds elapsed) {nullptr};
+    void (*m_onBlockAllocate)(std::size_t numBytes) {nullptr};
+    void (*m_onBlockDeallocate)() {nullptr};
+};
+
+inline instrumentation_hooks& instrumentation()
+{
+    static instrumentation_hooks hooks;
+    return hooks;
+}
+
+// Reports the time spent until the end of the enclosing scope
+struct HookTimer
+{
+    using Hook = void (*)(const std::type_info&, std::chrono::nanoseconds);
+
+    HookTimer(Hook hook, const std::type_info& signature) : m_hook(hook), m_signature(signature)
+    {
+        if (m_hook)
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    ~HookTimer()
+    {
+        if (m_hook)
+            m_hook(m_signature, std::chrono::steady_clock::now() - m_start);
+    }
+
+    Hook m_hook;
+    const std::type_info& m_signature;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#define MCO_HOOK(name, ...) do { if (auto mcoHook = ::xtd::instrumentation().name) mcoHook(__VA_ARGS__); } while (0)
+#define MCO_TIMED_HOOK(name, signature) ::xtd::HookTimer mcoHookTimer(::xtd::instrumentation().name, signature)
+#else
+#define MCO_HOOK(name, ...) do {} while (0)
+#define MCO_TIMED_HOOK(name, signature) do {} while (0)
+#endif
+
 template<class It>
 void reverse_destroy(It begin, It end)
 {
@@ -16,61 +87,435 @@ void reverse_destroy(It begin, It end)
     }
 }
 
+// Allocator placeholder used by the overloads that don't take one:
+// objects are created with placement new and destroyed with std::destroy_at
+struct NoAllocator {};
+
+template<class A, class = void>
+struct is_allocator : std::false_type {};
+
+template<class A>
+struct is_allocator<A, std::void_t<typename A::value_type, decltype(std::declval<A&>().allocate(std::size_t{}))>> : std::true_type {};
+
+template<class A>
+static constexpr bool is_allocator_v = is_allocator<A>::value;
+
+template<class T, class Alloc>
+struct ElementAllocator { using type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>; };
+
 template<class T>
+struct ElementAllocator<T, NoAllocator> { using type = NoAllocator; };
+
+template<class T, class... A>
+void constructAt(NoAllocator&, T* p, A&&... a) { new (p) T(std::forward<A>(a)...); }
+
+template<class Alloc, class T, class... A>
+void constructAt(Alloc& alloc, T* p, A&&... a) { std::allocator_traits<Alloc>::construct(alloc, p, std::forward<A>(a)...); }
+
+template<class T, class... A>
+void constructAggregateAt(NoAllocator&, T* p, A&&... a) { new (p) T{std::forward<A>(a)...}; }
+
+// allocator_traits::construct uses () so aggregates are built from a braced temporary
+template<class Alloc, class T, class... A>
+void constructAggregateAt(Alloc& alloc, T* p, A&&... a) { std::allocator_traits<Alloc>::construct(alloc, p, T{std::forward<A>(a)...}); }
+
+template<class T>
+void reverse_destroy(NoAllocator&, T* begin, T* end) { reverse_destroy(begin, end); }
+
+template<class Alloc, class T>
+void reverse_destroy(Alloc& alloc, T* begin, T* end)
+{
+    while (begin != end)
+    {
+        --end;
+        std::allocator_traits<Alloc>::destroy(alloc, end);
+    }
+}
+
+static constexpr std::size_t dynamic_extent = std::size_t(-1);
+
+// Spans with a static extent only store their begin
+template<class T, std::size_t Extent = dynamic_extent>
 struct span
 {
     using type = T;
+    static constexpr std::size_t extent = Extent;
+    static constexpr std::size_t alignment = alignof(T);
+    static constexpr std::size_t padding = 0;
+    auto begin() const { return m_begin; }
+    auto end() const { return m_begin + Extent; }
+    static constexpr std::size_t size() { return Extent; }
+    T* m_begin;
+};
+
+template<class T>
+struct span<T, dynamic_extent>
+{
+    using type = T;
+    static constexpr std::size_t extent = dynamic_extent;
+    static constexpr std::size_t alignment = alignof(T);
+    static constexpr std::size_t padding = 0;
     auto begin() const { return m_begin; }
     auto end() const { return m_end; }
+    std::size_t size() const { return m_end - m_begin; }
     T* m_begin;
     T* m_end;
 };
 
+// Span of a section placed on an Align boundary. When Pad is set, the section
+// also starts on a Pad boundary and whatever follows it starts on the next one.
+template<class T, std::size_t Align, std::size_t Pad, std::size_t Extent = dynamic_extent>
+struct aligned_span : span<T, Extent>
+{
+    static constexpr std::size_t alignment = std::max({Align, Pad, alignof(T)});
+    static constexpr std::size_t padding = Pad;
+};
+
+template<class... Spans>
+static constexpr std::size_t blockAlignment = std::max({Spans::alignment..., Spans::padding...});
+
+template<class Alloc, class T, std::size_t Extent>
+void reverse_destroy_with(Alloc& alloc, const span<T, Extent>& rng)
+{
+    typename ElementAllocator<T, Alloc>::type ea(alloc);
+    reverse_destroy(ea, rng.begin(), rng.end());
+}
+
+// Entries of the type list: T and T[] are sized at runtime, T[N] has a static extent
+template<class S>
+struct SectionTraits
+{
+    using type = S;
+    static constexpr std::size_t extent = dynamic_extent;
+};
+
+template<class T>
+struct SectionTraits<T[]>
+{
+    using type = T;
+    static constexpr std::size_t extent = dynamic_extent;
+};
+
+template<class T, std::size_t N>
+struct SectionTraits<T[N]>
+{
+    using type = T;
+    static constexpr std::size_t extent = N;
+};
+
+template<class... Sections>
+static constexpr std::size_t numDynamicSections = ((SectionTraits<Sections>::extent == dynamic_extent) + ... + 0);
+
+template<std::size_t I, class... Sections>
+constexpr std::size_t numDynamicSectionsBefore()
+{
+    constexpr bool dynamic[] = {SectionTraits<Sections>::extent == dynamic_extent...};
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < I; ++i)
+        n += dynamic[i];
+    return n;
+}
+
 constexpr std::uintptr_t findDistanceOfNextAlignedPosition(std::uintptr_t pos, std::size_t desiredAlignment)
 {
     return pos ? ((pos - 1u + desiredAlignment) & -desiredAlignment) - pos : 0;
 }
 
-template<class T>
+template<class T, std::size_t Align = alignof(T), std::size_t Pad = 0, std::size_t Extent = dynamic_extent>
 struct ArraySize
 {
+    using span_type = std::conditional_t<Align <= alignof(T) && Pad == 0, span<T, Extent>, aligned_span<T, Align, Pad, Extent>>;
     ArraySize(std::size_t count) : m_count(count) {}
-    std::size_t numBytes() const { return m_count*sizeof(T); }
+
+    std::size_t numBytes() const
+    {
+        if constexpr (Extent != dynamic_extent)
+            return Extent*sizeof(T);
+        else
+            return m_count*sizeof(T);
+    }
+
     std::size_t m_count;
 };
 
-template<class T>
-void addRequiredBytes(ArraySize<T>& init, std::size_t& pos)
+template<class T, std::size_t Align, std::size_t Pad, std::size_t Extent>
+void addRequiredBytes(ArraySize<T, Align, Pad, Extent>& init, std::size_t& pos)
 {
-    pos += findDistanceOfNextAlignedPosition(pos, alignof(T)) + init.numBytes();
+    using S = typename ArraySize<T, Align, Pad, Extent>::span_type;
+    pos += findDistanceOfNextAlignedPosition(pos, S::alignment) + init.numBytes();
+    if constexpr (Pad > 0)
+        pos += findDistanceOfNextAlignedPosition(pos, Pad);
 }
 
-template<class T>
-void setRange(ArraySize<T>& init, span<T>& rng, std::byte*& mem)
+// Positions are tracked relative to the block, which is aligned to every section. This gives the
+// same result as aligning the absolute addresses, but static sections fold into constant offsets.
+template<class T, std::size_t Align, std::size_t Pad, std::size_t Extent>
+void setRange(ArraySize<T, Align, Pad, Extent>& init, span<T, Extent>& rng, std::byte* mem, std::size_t& pos)
+{
+    using S = typename ArraySize<T, Align, Pad, Extent>::span_type;
+    pos += findDistanceOfNextAlignedPosition(pos, S::alignment);
+    rng.m_begin = reinterpret_cast<T*>(mem + pos);
+    pos += init.numBytes();
+    if constexpr (Extent == dynamic_extent)
+        rng.m_end = reinterpret_cast<T*>(mem + pos);
+    if constexpr (Pad > 0)
+        pos += findDistanceOfNextAlignedPosition(pos, Pad);
+}
+
+// Byte offset of section I from the start of the block, for layouts whose sections before I all
+// have a static extent (and no alignment modifiers). Lets handles rebuild spans from the block pointer alone.
+template<std::size_t I, class... Sections>
+constexpr std::size_t static_offset()
+{
+    constexpr std::size_t aligns[] = {alignof(typename SectionTraits<Sections>::type)...};
+    constexpr std::size_t sizes[] = {sizeof(typename SectionTraits<Sections>::type)...};
+    constexpr std::size_t extents[] = {SectionTraits<Sections>::extent...};
+
+    static_assert(numDynamicSectionsBefore<I, Sections...>() == 0, "every section before I must have a static extent");
+
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < I; ++i)
+    {
+        pos += findDistanceOfNextAlignedPosition(pos, aligns[i]) + extents[i]*sizes[i];
+    }
+    return pos + findDistanceOfNextAlignedPosition(pos, aligns[I]);
+}
+
+// Total size of a layout made only of static sections
+template<class... Sections>
+constexpr std::size_t static_layout_bytes()
 {
-    mem += findDistanceOfNextAlignedPosition(reinterpret_cast<std::uintptr_t>(mem), alignof(T));
-    rng.m_begin = reinterpret_cast<T*>(mem);
-    mem += init.numBytes();
-    rng.m_end = reinterpret_cast<T*>(mem);
+    constexpr auto last = sizeof...(Sections) - 1;
+    using T = std::tuple_element_t<last, std::tuple<Sections...>>;
+    static_assert(SectionTraits<T>::extent != dynamic_extent, "every section must have a static extent");
+    return static_offset<last, Sections...>() + SectionTraits<T>::extent*sizeof(typename SectionTraits<T>::type);
+}
+
+template<std::size_t I, class... Sections>
+auto get_static_section(void* block)
+{
+    using Tr = SectionTraits<std::tuple_element_t<I, std::tuple<Sections...>>>;
+    static_assert(Tr::extent != dynamic_extent, "section must have a static extent");
+    constexpr auto offset = static_offset<I, Sections...>();
+    return span<typename Tr::type, Tr::extent>{reinterpret_cast<typename Tr::type*>((std::byte*)block + offset)};
+}
+
+// ::operator new only guarantees __STDCPP_DEFAULT_NEW_ALIGNMENT__, switch to the aligned overloads above that
+template<std::size_t Align>
+void* allocateBlock(std::size_t numBytes)
+{
+    void* mem;
+    if constexpr (Align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        mem = ::operator new(numBytes, std::align_val_t{Align});
+    else
+        mem = ::operator new(numBytes);
+    MCO_HOOK(m_onBlockAllocate, numBytes); // only once allocated, live blocks stay balanced when new throws
+    return mem;
+}
+
+template<std::size_t Align>
+void deallocateBlock(void* mem)
+{
+    MCO_HOOK(m_onBlockDeallocate);
+    if constexpr (Align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        ::operator delete(mem, std::align_val_t{Align});
+    else
+        ::operator delete(mem);
+}
+
+// Sections are placed in memory following Order (an index_sequence over the sections),
+// the returned tuple is always in declaration order
+template<std::size_t... Order, class... Sizes>
+std::size_t requiredBytes(std::index_sequence<Order...>, std::tuple<Sizes...>& sizes)
+{
+    std::size_t numBytes = 0;
+    ((addRequiredBytes(std::get<Order>(sizes), numBytes), ...));
+    return numBytes;
+}
+
+template<std::size_t... Order, class... Sizes>
+auto setRanges(std::index_sequence<Order...>, std::tuple<Sizes...>& sizes, std::byte* mem)
+{
+    std::tuple<typename Sizes::span_type...> r;
+    std::size_t pos = 0;
+    ((setRange(std::get<Order>(sizes), std::get<Order>(r), mem, pos), ...));
+    return r;
+}
+
+template<class Order, class... Sizes>
+auto makeLayout(Order order, Sizes... args) -> std::tuple<typename Sizes::span_type...>
+{
+    std::tuple<Sizes...> sizes{args...};
+    auto numBytes = requiredBytes(order, sizes);
+    MCO_HOOK(m_onLayout, typeid(std::tuple<typename Sizes::span_type...>), (args.numBytes() + ... + 0),
+             numBytes - (args.numBytes() + ... + 0));
+
+    auto mem = (std::byte*) allocateBlock<blockAlignment<typename Sizes::span_type...>>(numBytes);
+
+    return setRanges(order, sizes, mem);
 }
 
 template<class... Args>
 auto make_contiguous_layout(ArraySize<Args>... args) -> std::tuple<span<Args>...>
 {
-    std::size_t numBytes = 0;
-    ((addRequiredBytes(args, numBytes), ...));
+    return makeLayout(std::index_sequence_for<Args...>{}, args...);
+}
 
-    auto mem = (std::byte*) ::operator new(numBytes);
+// Storage unit handed to allocators so the whole block honors the strictest alignment of the layout
+template<std::size_t Align>
+struct alignas(Align) StorageUnit { std::byte m_bytes[Align]; };
 
-    std::tuple<span<Args>...> r;
+template<class Alloc, class... Spans>
+using StorageAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<StorageUnit<blockAlignment<Spans...>>>;
 
-    std::apply([&] (auto&... targs) {
-        (setRange(args, targs, mem),...);
-    }, r);
+template<class... Spans>
+std::size_t numStorageUnits(std::size_t numBytes)
+{
+    constexpr auto unit = blockAlignment<Spans...>;
+    return numBytes ? (numBytes + unit - 1) / unit : 1;
+}
 
+// The block starts at the lowest address among the spans, which is not necessarily the first
+// one when the layout was reordered. Null spans are ignored so callers rebuilding a layout by
+// hand can leave out sections they don't need to destroy, except with an allocator: the size
+// given back to it is computed from the spans, which must then all be there.
+template<class... Spans>
+std::byte* layoutBegin(const std::tuple<Spans...>& t)
+{
+    std::byte* r = nullptr;
+    std::apply([&] (auto&... rngs) {
+        ((r = (rngs.begin() && (!r || (std::byte*)rngs.begin() < r)) ? (std::byte*)rngs.begin() : r), ...);
+    }, t);
     return r;
 }
 
+template<class... Spans>
+std::byte* layoutEnd(const std::tuple<Spans...>& t)
+{
+    std::byte* r = nullptr;
+    std::apply([&] (auto&... rngs) {
+        ((r = (std::byte*)rngs.end() > r ? (std::byte*)rngs.end() : r), ...);
+    }, t);
+    return r;
+}
+
+template<class... Spans>
+std::size_t numLayoutBytes(const std::tuple<Spans...>& t)
+{
+    return layoutEnd(t) - layoutBegin(t);
+}
+
+template<class Order, class Alloc, class... Sizes, class = std::enable_if_t<is_allocator_v<Alloc>>>
+auto makeLayout(Order order, Alloc& alloc, Sizes... args) -> std::tuple<typename Sizes::span_type...>
+{
+    std::tuple<Sizes...> sizes{args...};
+    auto numBytes = requiredBytes(order, sizes);
+    MCO_HOOK(m_onLayout, typeid(std::tuple<typename Sizes::span_type...>), (args.numBytes() + ... + 0),
+             numBytes - (args.numBytes() + ... + 0));
+
+    StorageAllocator<Alloc, typename Sizes::span_type...> salloc(alloc);
+    auto mem = (std::byte*) &*std::allocator_traits<decltype(salloc)>::allocate(
+        salloc, numStorageUnits<typename Sizes::span_type...>(numBytes));
+    MCO_HOOK(m_onBlockAllocate, numBytes);
+
+    return setRanges(order, sizes, mem);
+}
+
+template<class... Args, class Alloc, class = std::enable_if_t<is_allocator_v<Alloc>>>
+auto make_contiguous_layout(Alloc& alloc, ArraySize<Args>... args) -> std::tuple<span<Args>...>
+{
+    return makeLayout(std::index_sequence_for<Args...>{}, alloc, args...);
+}
+
+// Every span must be the one the layout was made with, the number of bytes is rebuilt from them
+template<class Alloc, class... Spans>
+void deallocate_contiguous_layout(Alloc& alloc, const std::tuple<Spans...>& t)
+{
+    assert(std::apply([] (auto&... rngs) { return (rngs.begin() && ...); }, t) && "sections can't be left out with an allocator");
+    MCO_HOOK(m_onBlockDeallocate);
+    StorageAllocator<Alloc, Spans...> salloc(alloc);
+    using Unit = StorageUnit<blockAlignment<Spans...>>;
+    std::allocator_traits<decltype(salloc)>::deallocate(
+        salloc, (Unit*)layoutBegin(t), numStorageUnits<Spans...>(numLayoutBytes(t)));
+}
+
+template<class... Spans>
+void deallocate_contiguous_layout(NoAllocator&, const std::tuple<Spans...>& t)
+{
+    deallocateBlock<blockAlignment<Spans...>>(layoutBegin(t));
+}
+
+struct DeclarationOrder
+{
+    template<class... Spans>
+    static auto order() { return std::index_sequence_for<Spans...>{}; }
+};
+
+// Stable sort of the sections by decreasing alignment. Sizes are multiples of the alignment,
+// so no padding is needed between sections placed in that order.
+template<class... Spans>
+constexpr auto packedOrder()
+{
+    std::array<std::size_t, sizeof...(Spans)> order {};
+    constexpr std::size_t aligns[] = {Spans::alignment...};
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        auto j = i;
+        for (; j > 0 && aligns[order[j - 1]] < aligns[i]; --j)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+    return order;
+}
+
+struct PackedOrder
+{
+    template<class... Spans, std::size_t... I>
+    static auto order(std::index_sequence<I...>) { return std::index_sequence<packedOrder<Spans...>()[I]...>{}; }
+
+    template<class... Spans>
+    static auto order() { return order<Spans...>(std::index_sequence_for<Spans...>{}); }
+};
+
+constexpr std::size_t lowestSetBit(std::size_t v) { return v & -v; }
+
+// Upper bound of the padding inserted between sections of the given (alignment, size) pairs,
+// whatever the element counts are
+template<std::size_t N>
+constexpr std::size_t worstCasePadding(const std::array<std::size_t, N>& aligns, const std::array<std::size_t, N>& sizes)
+{
+    std::size_t padding = 0;
+    std::size_t guaranteed = ~(std::size_t(-1) >> 1); // sections are placed relative to a fully aligned base
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (guaranteed < aligns[i])
+            padding += aligns[i] - guaranteed;
+        guaranteed = std::min(std::max(guaranteed, aligns[i]), lowestSetBit(sizes[i]));
+    }
+    return padding;
+}
+
+template<class... Args>
+constexpr std::size_t worst_case_padding()
+{
+    return worstCasePadding<sizeof...(Args)>({alignof(Args)...}, {sizeof(Args)...});
+}
+
+template<class... Args>
+constexpr std::size_t worst_case_packed_padding()
+{
+    constexpr std::array<std::size_t, sizeof...(Args)> aligns {alignof(Args)...};
+    constexpr std::array<std::size_t, sizeof...(Args)> sizes {sizeof(Args)...};
+    constexpr auto order = packedOrder<span<Args>...>();
+    std::array<std::size_t, sizeof...(Args)> sortedAligns {}, sortedSizes {};
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        sortedAligns[i] = aligns[order[i]];
+        sortedSizes[i] = sizes[order[i]];
+    }
+    return worstCasePadding(sortedAligns, sortedSizes);
+}
+
 struct uninit_t{}; static constexpr uninit_t uninit;
 struct ctor_t{}; static constexpr ctor_t ctor;
 struct aggregate_t{}; static constexpr aggregate_t aggregate;
@@ -106,11 +551,49 @@ auto arg(input_iterator_t, std::size_t count, const It& it) { return Initializer
 template<class Fn>
 auto arg(functor_t, std::size_t count, const Fn& fn) { return InitializerConfiguration<functor_t, const Fn&>{count, fn}; }
 
-template<class T>
+static constexpr std::size_t cache_line_size = 64;
+static constexpr std::size_t page_size = 4096; // smallest page size of the supported platforms
+
+template<std::size_t N> struct aligned_t{}; template<std::size_t N> static constexpr aligned_t<N> aligned;
+template<std::size_t N> struct padded_t{}; template<std::size_t N> static constexpr padded_t<N> padded;
+
+template<std::size_t Align, std::size_t Pad, class Inner>
+struct AlignedConfiguration
+{
+    Inner m_inner;
+};
+
+// arg(aligned<64>, ...) places the section on a 64 byte boundary,
+// arg(padded<cache_line_size>, ...) also keeps whatever follows off its last cache line
+template<std::size_t N, class... Args>
+auto arg(aligned_t<N>, Args&&... args)
+{
+    static_assert(N && !(N & (N - 1)), "alignment must be a power of two");
+    auto inner = arg(std::forward<Args>(args)...);
+    return AlignedConfiguration<N, 0, decltype(inner)>{inner};
+}
+
+template<std::size_t N, class... Args>
+auto arg(padded_t<N>, Args&&... args)
+{
+    static_assert(N && !(N & (N - 1)), "padding must be a power of two");
+    auto inner = arg(std::forward<Args>(args)...);
+    return AlignedConfiguration<N, N, decltype(inner)>{inner};
+}
+
+// For the handles that compute offsets from natural alignments and reject alignment modifiers
+template<class Init>
+struct IsAlignedInitializer : std::false_type {};
+
+template<std::size_t Align, std::size_t Pad, class Inner>
+struct IsAlignedInitializer<AlignedConfiguration<Align, Pad, Inner>> : std::true_type {};
+
+template<class T, class Alloc = NoAllocator>
 struct RangeGuard
 {
     using type = T;
-    RangeGuard(span<T>& rng) : m_rng(rng), m_next(m_rng.begin()) {}
+    template<std::size_t Extent>
+    RangeGuard(span<T, Extent>& rng, Alloc& alloc) : m_begin(rng.begin()), m_next(rng.begin()), m_alloc(alloc) {}
 
     void release()
     {
@@ -120,46 +603,153 @@ struct RangeGuard
     ~RangeGuard()
     {
         if (m_next)
-            reverse_destroy(m_rng.begin(), m_next);
+            reverse_destroy(m_alloc, m_begin, m_next);
     }
 
-    span<T>& m_rng;
+    T* m_begin;
     T* m_next;
+    Alloc& m_alloc;
+};
+
+// Iterators known to point into contiguous storage. Specialize for other iterator types.
+template<class It>
+struct is_contiguous_iterator : std::is_pointer<It> {};
+
+template<class It, class = void>
+struct IsStdContiguousIterator : std::false_type {};
+
+template<class It>
+struct IsStdContiguousIterator<It, std::enable_if_t<!std::is_pointer_v<It>, std::void_t<typename std::iterator_traits<It>::value_type>>>
+{
+    using V = typename std::iterator_traits<It>::value_type;
+    static constexpr bool value =
+        std::is_same_v<It, typename std::vector<V>::iterator> || std::is_same_v<It, typename std::vector<V>::const_iterator> ||
+        std::is_same_v<It, typename std::basic_string<V>::iterator> || std::is_same_v<It, typename std::basic_string<V>::const_iterator>;
+};
+
+template<class It>
+static constexpr bool isContiguousIterator = is_contiguous_iterator<It>::value || IsStdContiguousIterator<It>::value;
+
+// Only objects that would have been built with a plain placement new can be initialized in bulk
+template<class EA>
+static constexpr bool constructsInPlace = std::is_same_v<EA, NoAllocator>;
+
+template<class T>
+static constexpr bool constructsInPlace<std::allocator<T>> = true;
+
+// Zero bits are the value-initialized representation of these types
+template<class T>
+static constexpr bool isZeroInitializable = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+template<class T, class Config>
+struct BulkInit { static constexpr bool value = false; };
+
+template<class T>
+struct BulkInit<T, InitializerConfiguration<uninit_t, int>>
+{
+    static constexpr bool value = std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+};
+
+// Value-initialization (zeroes) or construction from the same arguments, for scalars
+template<class T, class... Args>
+struct BulkInit<T, InitializerConfiguration<ctor_t, std::tuple<Args...>>>
+{
+    static constexpr bool value = isZeroInitializable<T> && std::is_nothrow_constructible_v<T, Args&...>;
 };
 
-template<class Tup, class T, class... U>
-void initRanges(Tup& t, T&& ac, U&&... acs)
+template<class T, class It>
+struct BulkInit<T, InitializerConfiguration<input_iterator_t, It>>
+{
+    static constexpr bool value = isContiguousIterator<It> && std::is_trivially_copyable_v<T> &&
+        std::is_same_v<T, std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<It&>())>>>;
+};
+
+// Sections handled here are trivially destructible and can't throw, so they need no RangeGuard
+template<class T, std::size_t Extent, class Config>
+void bulkInitialize(span<T, Extent>& rng, Config& ac)
+{
+    using Command = typename Config::command;
+    auto count = std::size_t(rng.end() - rng.begin());
+    if (!count)
+        return;
+
+    if constexpr (std::is_same_v<Command, ctor_t>)
+    {
+        if constexpr (std::tuple_size_v<decltype(ac.m_args)> == 0)
+            std::memset((void*)rng.begin(), 0, count*sizeof(T));
+        else
+        {
+            // Doubling copies go through the vectorized memcpy whatever the count, a plain fill
+            // loop with a runtime trip count is left scalar at -O2
+            auto begin = rng.begin();
+            std::apply([&] (auto&&... args) { new (begin) T(args...); }, ac.m_args);
+            if constexpr (sizeof(T) == 1)
+                std::memset((void*)begin, (int)*(unsigned char*)begin, count);
+            else
+                for (std::size_t done = 1; done < count; done *= 2)
+                    std::memcpy((void*)(begin + done), (const void*)begin, std::min(done, count - done)*sizeof(T));
+        }
+    }
+
+    if constexpr (std::is_same_v<Command, input_iterator_t>)
+        std::memcpy((void*)rng.begin(), (const void*)std::addressof(*ac.m_args), count*sizeof(T));
+}
+
+template<class Alloc, class Tup, class T, class... U>
+void initRanges(Alloc& alloc, Tup& t, T&& ac, U&&... acs)
 {
     constexpr int tupPos = std::tuple_size_v<Tup> - sizeof...(acs) - 1;
 
     auto& rng = std::get<tupPos>(t);
 
-    RangeGuard g(rng);
+    using TheT = typename std::remove_reference_t<decltype(rng)>::type;
+    using EA = typename ElementAllocator<TheT, Alloc>::type;
     using DT = std::remove_cv_t<std::remove_reference_t<T>>;
-    using TheT = typename decltype(g)::type;
 
-    for (; g.m_next != rng.end(); ++g.m_next)
+    if constexpr (constructsInPlace<EA> && BulkInit<TheT, DT>::value)
+    {
+        bulkInitialize(rng, ac);
+        if constexpr (sizeof...(acs)>0)
+            initRanges(alloc, t, acs...);
+        return;
+    }
+    else
     {
-        if constexpr (std::is_same_v<typename DT::command, uninit_t>) 
-            new (g.m_next) TheT;
+        EA ea(alloc);
 
-        if constexpr (std::is_same_v<typename DT::command, ctor_t>) 
-            std::apply([&] (auto&&... args) { new (g.m_next) TheT(args...); }, ac.m_args);
+        RangeGuard<TheT, EA> g(rng, ea);
 
-        if constexpr (std::is_same_v<typename DT::command, aggregate_t>) 
-            std::apply([&] (auto&&... args) { new (g.m_next) TheT{args...}; }, ac.m_args);
+        for (; g.m_next != rng.end(); ++g.m_next)
+        {
+            // uninit never goes through the allocator, see README
+            if constexpr (std::is_same_v<typename DT::command, uninit_t>) 
+                new (g.m_next) TheT;
 
-        if constexpr (std::is_same_v<typename DT::command, input_iterator_t>) 
-            new (g.m_next) TheT(*ac.m_args++);
+            if constexpr (std::is_same_v<typename DT::command, ctor_t>) 
+                std::apply([&] (auto&&... args) { constructAt(ea, g.m_next, args...); }, ac.m_args);
 
-        if constexpr (std::is_same_v<typename DT::command, functor_t>) 
-            new (g.m_next) TheT(ac.m_args());
-    }
+            if constexpr (std::is_same_v<typename DT::command, aggregate_t>) 
+                std::apply([&] (auto&&... args) { constructAggregateAt(ea, g.m_next, args...); }, ac.m_args);
 
-    if constexpr (sizeof...(acs)>0)
-        initRanges(t, acs...);
+            if constexpr (std::is_same_v<typename DT::command, input_iterator_t>) 
+                constructAt(ea, g.m_next, *ac.m_args++);
 
-    g.release();
+            if constexpr (std::is_same_v<typename DT::command, functor_t>) 
+                constructAt(ea, g.m_next, ac.m_args());
+        }
+
+        if constexpr (sizeof...(acs)>0)
+            initRanges(alloc, t, acs...);
+
+        g.release();
+    }
+}
+
+template<class Tup, class... U>
+void initRanges(Tup& t, U&&... acs)
+{
+    NoAllocator na;
+    initRanges(na, t, std::forward<U>(acs)...);
 }
 
 
@@ -171,40 +761,361 @@ auto convert_arg(std::size_t sz) { return arg(sz); }
 template<class T>
 std::enable_if_t<!std::is_integral_v<T>, T> convert_arg(const T& t) { return t; }
 
+template<std::size_t Align, std::size_t Pad, class Inner>
+std::size_t get_size(const AlignedConfiguration<Align, Pad, Inner>& t) { return get_size(t.m_inner); }
+
+template<std::size_t Align, std::size_t Pad, class Inner>
+auto convert_arg(const AlignedConfiguration<Align, Pad, Inner>& t) { return convert_arg(t.m_inner); }
+
+template<class S, std::size_t Align = alignof(typename SectionTraits<S>::type), std::size_t Pad = 0>
+auto sectionSizeWith(std::size_t count)
+{
+    using Tr = SectionTraits<S>;
+    if (Tr::extent != dynamic_extent && Tr::extent != count)
+        throw std::length_error("make_contiguous_objects: initializer count must match the static extent");
+    return ArraySize<typename Tr::type, Align, Pad, Tr::extent>(count);
+}
+
+template<class S, class Init>
+auto sectionSize(const Init& init) { return sectionSizeWith<S>(get_size(init)); }
+
+template<class S, std::size_t Align, std::size_t Pad, class Inner>
+auto sectionSize(const AlignedConfiguration<Align, Pad, Inner>& init) { return sectionSizeWith<S, Align, Pad>(get_size(init)); }
+
+// Static sections may be left out of the initializer list, they are then value-initialized
+template<std::size_t I, class... Sections, class Tup>
+auto initializerFor(const Tup& inits)
+{
+    using Tr = SectionTraits<std::tuple_element_t<I, std::tuple<Sections...>>>;
+    if constexpr (Tr::extent != dynamic_extent)
+        return Tr::extent;
+    else
+        return std::get<numDynamicSectionsBefore<I, Sections...>()>(inits);
+}
+
+template<class... Sections, class Fn, class... Initializers, std::size_t... I>
+auto completeInitializers(Fn&& fn, std::index_sequence<I...>, const Initializers&... args)
+{
+    static_assert(sizeof...(Initializers) == numDynamicSections<Sections...>,
+                  "expected one initializer per section, or one per dynamic section");
+    auto inits = std::forward_as_tuple(args...);
+    return fn(initializerFor<I, Sections...>(inits)...);
+}
+
+template<std::size_t Align>
 struct MemGuard
 {
-    ~MemGuard() { ::operator delete(m_mem); }
+    ~MemGuard() { if (m_mem) deallocateBlock<Align>(m_mem); }
     void release() { m_mem = nullptr; }
     void* m_mem;
 };
 
+template<class OrderPolicy, class... Args, class... Initializers>
+auto makeObjects(Initializers... args)
+{
+    if constexpr (sizeof...(Initializers) != sizeof...(Args))
+    {
+        return completeInitializers<Args...>([] (auto... inits) { return makeObjects<OrderPolicy, Args...>(inits...); },
+                                             std::index_sequence_for<Args...>{}, args...);
+    }
+    else
+    {
+        auto layout = makeLayout(OrderPolicy::template order<typename decltype(sectionSize<Args>(args))::span_type...>(),
+                                 sectionSize<Args>(args)...);
+        MemGuard<blockAlignment<typename decltype(sectionSize<Args>(args))::span_type...>> mg{layoutBegin(layout)};
+
+        MCO_TIMED_HOOK(m_onConstruct, typeid(decltype(layout)));
+        initRanges(layout, convert_arg(args)...);
+
+        mg.release();
+        return layout;
+    }
+}
+
+template<class Alloc, class Layout>
+struct AllocatorMemGuard
+{
+    ~AllocatorMemGuard() { if (m_layout) deallocate_contiguous_layout(m_alloc, *m_layout); }
+    void release() { m_layout = nullptr; }
+    Alloc& m_alloc;
+    const Layout* m_layout;
+};
+
+template<class OrderPolicy, class... Args, class Alloc, class... Initializers>
+auto makeObjectsWith(Alloc& alloc, Initializers... args)
+{
+    if constexpr (sizeof...(Initializers) != sizeof...(Args))
+    {
+        return completeInitializers<Args...>([&] (auto... inits) { return makeObjectsWith<OrderPolicy, Args...>(alloc, inits...); },
+                                             std::index_sequence_for<Args...>{}, args...);
+    }
+    else
+    {
+        auto layout = makeLayout(OrderPolicy::template order<typename decltype(sectionSize<Args>(args))::span_type...>(),
+                                 alloc, sectionSize<Args>(args)...);
+        AllocatorMemGuard<Alloc, decltype(layout)> mg{alloc, &layout};
+
+        MCO_TIMED_HOOK(m_onConstruct, typeid(decltype(layout)));
+        initRanges(alloc, layout, convert_arg(args)...);
+
+        mg.release();
+        return layout;
+    }
+}
+
 template<class... Args, class... Initializers>
-auto make_contiguous_objects(Initializers... args) -> std::tuple<span<Args>...>
+auto make_contiguous_objects(Initializers... args)
 {
-    auto layout = make_contiguous_layout<Args...>(get_size(args)...);
-    MemGuard mg{std::get<0>(layout).begin()};
+    return makeObjects<DeclarationOrder, Args...>(args...);
+}
 
-    initRanges(layout, convert_arg(args)...);
+template<class... Args, class Alloc, class... Initializers, class = std::enable_if_t<is_allocator_v<Alloc>>>
+auto make_contiguous_objects(Alloc& alloc, Initializers... args)
+{
+    return makeObjectsWith<DeclarationOrder, Args...>(alloc, args...);
+}
 
-    mg.release();
-    return layout;
+// Same as make_contiguous_objects, but the arrays are placed in memory by decreasing alignment
+// to minimize padding. The tuple and the construction order still follow Args.
+template<class... Args, class... Initializers>
+auto make_contiguous_objects_packed(Initializers... args)
+{
+    return makeObjects<PackedOrder, Args...>(args...);
+}
+
+template<class... Args, class Alloc, class... Initializers, class = std::enable_if_t<is_allocator_v<Alloc>>>
+auto make_contiguous_objects_packed(Alloc& alloc, Initializers... args)
+{
+    return makeObjectsWith<PackedOrder, Args...>(alloc, args...);
+}
+
+template<class Tup, class Fn, std::size_t... I>
+void forEachReversed(const Tup& t, Fn&& fn, std::index_sequence<I...>)
+{
+    (fn(std::get<sizeof...(I) - 1 - I>(t)), ...);
 }
 
 template<class... Args>
 void destroy_contiguous_objects(const std::tuple<Args...>& t)
 {
-    std::apply([] (auto&... rngs) {
-        (reverse_destroy(rngs.begin(), rngs.end()),...);
-    }, t);
+    {
+        MCO_TIMED_HOOK(m_onDestroy, typeid(std::tuple<Args...>));
+        forEachReversed(t, [] (auto& rng) {
+            reverse_destroy(rng.begin(), rng.end());
+        }, std::index_sequence_for<Args...>{});
+    }
+
+    deallocateBlock<blockAlignment<Args...>>(layoutBegin(t));
+}
+
+template<class Alloc, class... Spans>
+void destroy_contiguous_objects(Alloc& alloc, const std::tuple<Spans...>& t)
+{
+    {
+        MCO_TIMED_HOOK(m_onDestroy, typeid(std::tuple<Spans...>));
+        forEachReversed(t, [&] (auto& rng) {
+            reverse_destroy_with(alloc, rng);
+        }, std::index_sequence_for<Spans...>{});
+    }
+
+    deallocate_contiguous_layout(alloc, t);
+}
+
+// Size of a section recovered from the type of its span, alignment modifiers included
+template<class Span>
+struct SpanSize;
+
+template<class T, std::size_t Extent>
+struct SpanSize<span<T, Extent>> { using type = ArraySize<T, alignof(T), 0, Extent>; };
+
+template<class T, std::size_t Align, std::size_t Pad, std::size_t Extent>
+struct SpanSize<aligned_span<T, Align, Pad, Extent>> { using type = ArraySize<T, Align, Pad, Extent>; };
+
+// One count per section, or one per dynamic section
+template<class... Spans, class... Counts>
+constexpr auto resizedCounts(Counts... counts) -> std::array<std::size_t, sizeof...(Spans)>
+{
+    if constexpr (sizeof...(Counts) == sizeof...(Spans))
+    {
+        std::array<std::size_t, sizeof...(Spans)> r {std::size_t(counts)...};
+        std::array<std::size_t, sizeof...(Spans)> extents {Spans::extent...};
+        // Also rejects a mismatch at compile time when evaluated in a constant expression
+        for (std::size_t i = 0; i < sizeof...(Spans); ++i)
+            if (extents[i] != dynamic_extent && extents[i] != r[i])
+                throw std::length_error("count must match the static extent");
+        return r;
+    }
+    else
+    {
+        static_assert(sizeof...(Counts) == ((Spans::extent == dynamic_extent) + ... + 0),
+                      "expected one count per section, or one per dynamic section");
+        std::array<std::size_t, sizeof...(Counts)> dynamic {std::size_t(counts)...};
+        std::size_t j = 0;
+        return {(Spans::extent != dynamic_extent ? Spans::extent : dynamic[j++])...};
+    }
+}
+
+// Kept elements are copied rather than moved when the move could throw, so the old layout
+// stays intact until nothing can fail anymore (std::move_if_noexcept)
+template<class T>
+static constexpr bool relocatesByCopy = std::is_trivially_copyable_v<T> ||
+    (!std::is_nothrow_move_constructible_v<T> && std::is_copy_constructible_v<T>);
+
+// Sections can only be shifted inside the block when nothing can throw halfway through
+template<class Alloc, class T>
+static constexpr bool shiftsInPlace = std::is_trivially_copyable_v<T> && std::is_nothrow_default_constructible_v<T> &&
+    constructsInPlace<typename ElementAllocator<T, Alloc>::type>;
 
-    ::operator delete((void*)std::get<0>(t).begin());
+template<class T>
+auto relocationArg(std::size_t count, T* from)
+{
+    if constexpr (relocatesByCopy<T>)
+        return arg(input_iterator, count, (const T*)from);
+    else
+        return arg(input_iterator, count, std::make_move_iterator(from));
+}
+
+template<class Alloc, class Layout>
+struct ObjectsGuard
+{
+    ~ObjectsGuard()
+    {
+        if (m_layout)
+            forEachReversed(*m_layout, [&] (auto& rng) { reverse_destroy_with(m_alloc, rng); },
+                            std::make_index_sequence<std::tuple_size_v<Layout>>{});
+    }
+    void release() { m_layout = nullptr; }
+    Alloc& m_alloc;
+    const Layout* m_layout;
+};
+
+// Moves the kept prefix of every section to its new offset in the same block. Sections keep their
+// relative order, so moving the ones going down in increasing address order, then the ones going up
+// in decreasing address order, never overwrites data that is still to be moved.
+template<class... Spans, std::size_t... Order>
+void shiftSections(const std::tuple<Spans...>& from, const std::tuple<Spans...>& to,
+                   const std::array<std::size_t, sizeof...(Spans)>& keep, std::index_sequence<Order...>)
+{
+    using Layout = std::tuple<Spans...>;
+    std::byte* src[] = {(std::byte*)std::get<Order>(from).begin()...};
+    std::byte* dst[] = {(std::byte*)std::get<Order>(to).begin()...};
+    std::size_t bytes[] = {keep[Order]*sizeof(typename std::tuple_element_t<Order, Layout>::type)...};
+
+    for (std::size_t i = 0; i < sizeof...(Spans); ++i)
+        if (dst[i] < src[i])
+            std::memmove(dst[i], src[i], bytes[i]);
+
+    for (std::size_t i = sizeof...(Spans); i-- > 0;)
+        if (dst[i] > src[i])
+            std::memmove(dst[i], src[i], bytes[i]);
+}
+
+template<class OrderPolicy, class Alloc, class... Spans, std::size_t... I>
+auto resizeObjects(Alloc& alloc, const std::tuple<Spans...>& t, const std::array<std::size_t, sizeof...(Spans)>& counts,
+                   std::index_sequence<I...>) -> std::tuple<Spans...>
+{
+    using Layout = std::tuple<Spans...>;
+    auto order = OrderPolicy::template order<Spans...>();
+    std::tuple<typename SpanSize<Spans>::type...> oldSizes {std::get<I>(t).size()...};
+    std::tuple<typename SpanSize<Spans>::type...> newSizes {counts[I]...};
+    std::array<std::size_t, sizeof...(Spans)> keep {std::min<std::size_t>(std::get<I>(t).size(), counts[I])...};
+
+    // Reuse the block when the new layout fits in it. Allocators are given back the size they handed
+    // out, so with an allocator the block is only reused when that size doesn't change.
+    auto resized = setRanges(order, newSizes, layoutBegin(t));
+    bool fits;
+    if constexpr (std::is_same_v<Alloc, NoAllocator>)
+        fits = requiredBytes(order, newSizes) <= requiredBytes(order, oldSizes);
+    else
+        fits = numStorageUnits<Spans...>(numLayoutBytes(resized)) == numStorageUnits<Spans...>(numLayoutBytes(t));
+
+    bool shifts = ((std::get<I>(resized).begin() != std::get<I>(t).begin()) || ...);
+
+    if (fits && (!shifts || (shiftsInPlace<Alloc, typename Spans::type> && ...)))
+    {
+        if constexpr ((shiftsInPlace<Alloc, typename Spans::type> && ...))
+            if (shifts)
+                shiftSections(t, resized, keep, order);
+
+        // Only throws when nothing was shifted, initRanges then rolls back the new elements
+        std::tuple<span<typename Spans::type>...> grown {{std::get<I>(resized).begin() + keep[I], std::get<I>(resized).end()}...};
+        initRanges(alloc, grown, arg(std::get<I>(grown).size())...);
+
+        std::tuple<span<typename Spans::type>...> dropped {{std::get<I>(t).begin() + keep[I], std::get<I>(t).end()}...};
+        if (!shifts)
+            forEachReversed(dropped, [&] (auto& rng) { reverse_destroy_with(alloc, rng); }, std::index_sequence<I...>{});
+        return resized;
+    }
+
+    // Otherwise every section is relocated to a new block. New elements are created first, then the
+    // kept ones that are copied, and last the ones moved without throwing: the old layout is only
+    // modified once nothing can fail anymore.
+    Layout fresh;
+    if constexpr (std::is_same_v<Alloc, NoAllocator>)
+        fresh = makeLayout(order, typename SpanSize<Spans>::type(counts[I])...);
+    else
+        fresh = makeLayout(order, alloc, typename SpanSize<Spans>::type(counts[I])...);
+    AllocatorMemGuard<Alloc, Layout> mg{alloc, &fresh};
+
+    std::tuple<span<typename Spans::type>...> grown {{std::get<I>(fresh).begin() + keep[I], std::get<I>(fresh).end()}...};
+    initRanges(alloc, grown, arg(keep[I] < counts[I] ? counts[I] - keep[I] : 0)...);
+    ObjectsGuard<Alloc, decltype(grown)> gg{alloc, &grown};
+
+    std::tuple<span<typename Spans::type>...> copied {{std::get<I>(fresh).begin(),
+        std::get<I>(fresh).begin() + (relocatesByCopy<typename Spans::type> ? keep[I] : 0)}...};
+    initRanges(alloc, copied, relocationArg(std::get<I>(copied).size(), std::get<I>(t).begin())...);
+    ObjectsGuard<Alloc, decltype(copied)> cg{alloc, &copied};
+
+    std::tuple<span<typename Spans::type>...> moved {{std::get<I>(fresh).begin(),
+        std::get<I>(fresh).begin() + (relocatesByCopy<typename Spans::type> ? 0 : keep[I])}...};
+    initRanges(alloc, moved, relocationArg(std::get<I>(moved).size(), std::get<I>(t).begin())...);
+
+    cg.release();
+    gg.release();
+    mg.release();
+
+    destroy_contiguous_objects(alloc, t);
+    return fresh;
+}
+
+// Changes the number of elements of each section of a layout made by make_contiguous_objects.
+// Kept elements are preserved, new ones are value-initialized and dropped ones destroyed. The block
+// is reused when the new layout fits in it, otherwise the sections are relocated to a new one.
+// If an exception is thrown, t is left untouched. On success t must no longer be used.
+template<class... Spans, class... Counts>
+auto resize_contiguous_objects(const std::tuple<Spans...>& t, Counts... counts) -> std::tuple<Spans...>
+{
+    NoAllocator na;
+    return resizeObjects<DeclarationOrder>(na, t, resizedCounts<Spans...>(counts...), std::index_sequence_for<Spans...>{});
+}
+
+template<class Alloc, class... Spans, class... Counts, class = std::enable_if_t<is_allocator_v<Alloc>>>
+auto resize_contiguous_objects(Alloc& alloc, const std::tuple<Spans...>& t, Counts... counts) -> std::tuple<Spans...>
+{
+    return resizeObjects<DeclarationOrder>(alloc, t, resizedCounts<Spans...>(counts...), std::index_sequence_for<Spans...>{});
+}
+
+// For layouts made by make_contiguous_objects_packed
+template<class... Spans, class... Counts>
+auto resize_contiguous_objects_packed(const std::tuple<Spans...>& t, Counts... counts) -> std::tuple<Spans...>
+{
+    NoAllocator na;
+    return resizeObjects<PackedOrder>(na, t, resizedCounts<Spans...>(counts...), std::index_sequence_for<Spans...>{});
+}
+
+template<class Alloc, class... Spans, class... Counts, class = std::enable_if_t<is_allocator_v<Alloc>>>
+auto resize_contiguous_objects_packed(Alloc& alloc, const std::tuple<Spans...>& t, Counts... counts) -> std::tuple<Spans...>
+{
+    return resizeObjects<PackedOrder>(alloc, t, resizedCounts<Spans...>(counts...), std::index_sequence_for<Spans...>{});
 }
 
-template<class T, class U>
+// Align must match the alignment requested for the section starting at the returned address,
+// or the padding of the section ending at `end` (arg(aligned<N>, ...) / arg(padded<N>, ...)).
+template<class T, std::size_t Align = alignof(T), class U>
 T* get_adjacent_address(U* end)
 {
     auto endi = (std::uintptr_t)end;
-    return (T*) (endi + findDistanceOfNextAlignedPosition(endi, alignof(T)));
+    return (T*) (endi + findDistanceOfNextAlignedPosition(endi, std::max(Align, alignof(T))));
 } 
 
 }
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "mco.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace xtd
+{
+
+// Bump-pointer arena. Allocations are never freed individually: release() or
+// the destructor returns every chunk at once, which makes it a good fit for
+// request-scoped layouts.
+struct monotonic_arena
+{
+    struct Chunk
+    {
+        Chunk* m_prev;
+        std::size_t m_size;
+    };
+
+    explicit monotonic_arena(std::size_t chunkSize = 64*1024) : m_chunkSize(chunkSize) {}
+
+    // Start from a caller-provided buffer (e.g. on the stack) before touching the heap
+    monotonic_arena(void* buffer, std::size_t size, std::size_t chunkSize = 64*1024)
+        : m_cur((std::byte*)buffer), m_end((std::byte*)buffer + size), m_chunkSize(chunkSize) {}
+
+    monotonic_arena(const monotonic_arena&) = delete;
+    monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+    ~monotonic_arena() { release(); }
+
+    void* allocate(std::size_t numBytes, std::size_t alignment)
+    {
+        auto pos = reinterpret_cast<std::uintptr_t>(m_cur);
+        auto pad = findDistanceOfNextAlignedPosition(pos, alignment);
+        if (!m_cur || std::size_t(m_end - m_cur) < pad + numBytes)
+        {
+            addChunk(numBytes + alignment);
+            pos = reinterpret_cast<std::uintptr_t>(m_cur);
+            pad = findDistanceOfNextAlignedPosition(pos, alignment);
+        }
+
+        auto r = m_cur + pad;
+        m_cur = r + numBytes;
+        m_used += pad + numBytes;
+        return r;
+    }
+
+    // Give back every chunk. Objects living in the arena must have been destroyed already.
+    void release()
+    {
+        while (m_head)
+        {
+            auto prev = m_head->m_prev;
+            ::operator delete(m_head);
+            m_head = prev;
+        }
+        m_cur = m_end = nullptr;
+        m_used = 0;
+    }
+
+    std::size_t bytes_used() const { return m_used; }
+
+    void addChunk(std::size_t minBytes)
+    {
+        auto size = std::max(m_chunkSize, minBytes + sizeof(Chunk));
+        auto chunk = (Chunk*) ::operator new(size);
+        chunk->m_prev = m_head;
+        chunk->m_size = size;
+        m_head = chunk;
+        m_cur = (std::byte*)(chunk + 1);
+        m_end = (std::byte*)chunk + size;
+    }
+
+    Chunk* m_head {nullptr};
+    std::byte* m_cur {nullptr};
+    std::byte* m_end {nullptr};
+    std::size_t m_chunkSize;
+    std::size_t m_used {0};
+};
+
+template<class T>
+struct arena_allocator
+{
+    using value_type = T;
+
+    arena_allocator(monotonic_arena& arena) noexcept : m_arena(&arena) {}
+
+    template<class U>
+    arena_allocator(const arena_allocator<U>& other) noexcept : m_arena(other.m_arena) {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+        return (T*) m_arena->allocate(n*sizeof(T), alignof(T));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    monotonic_arena* m_arena;
+};
+
+template<class T, class U>
+bool operator==(const arena_allocator<T>& a, const arena_allocator<U>& b) { return a.m_arena == b.m_arena; }
+
+template<class T, class U>
+bool operator!=(const arena_allocator<T>& a, const arena_allocator<U>& b) { return a.m_arena != b.m_arena; }
+
+// Power-of-two size classes cached per thread. Blocks freed on another thread
+// simply join that thread's cache; every block is an individual ::operator new
+// allocation so any thread can eventually hand it back to the global heap.
+struct thread_pool
+{
+    static constexpr std::size_t s_minClassBytes = 16;
+    static constexpr std::size_t s_numClasses = 10; // 16B .. 8KiB
+    static constexpr std::size_t s_maxCachedBytesPerClass = 256*1024;
+
+    struct FreeNode { FreeNode* m_next; };
+
+    static thread_pool* local()
+    {
+        thread_local thread_pool pool;
+        return s_destroyed() ? nullptr : &pool;
+    }
+
+    // Trivially destructible, so it can still be read after the pool itself is gone
+    static bool& s_destroyed()
+    {
+        thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    static std::size_t sizeClass(std::size_t numBytes)
+    {
+        std::size_t cls = 0;
+        for (auto sz = s_minClassBytes; sz < numBytes; sz *= 2)
+            ++cls;
+        return cls;
+    }
+
+    static std::size_t classBytes(std::size_t cls) { return s_minClassBytes << cls; }
+
+    // Bytes allocated for a request, the whole class for cacheable sizes so the block fits any later use of that class
+    static std::size_t blockBytes(std::size_t numBytes)
+    {
+        auto cls = sizeClass(numBytes);
+        return cls < s_numClasses ? classBytes(cls) : numBytes;
+    }
+
+    void* allocate(std::size_t numBytes)
+    {
+        auto cls = sizeClass(numBytes);
+        if (cls >= s_numClasses)
+            return ::operator new(numBytes);
+
+        if (auto node = m_free[cls])
+        {
+            m_free[cls] = node->m_next;
+            m_cachedBytes[cls] -= classBytes(cls);
+            return node;
+        }
+        return ::operator new(classBytes(cls));
+    }
+
+    void deallocate(void* p, std::size_t numBytes) noexcept
+    {
+        auto cls = sizeClass(numBytes);
+        if (cls >= s_numClasses || m_cachedBytes[cls] + classBytes(cls) > s_maxCachedBytesPerClass)
+            return ::operator delete(p);
+
+        auto node = (FreeNode*)p;
+        node->m_next = m_free[cls];
+        m_free[cls] = node;
+        m_cachedBytes[cls] += classBytes(cls);
+    }
+
+    ~thread_pool()
+    {
+        s_destroyed() = true;
+        for (auto node : m_free)
+        {
+            while (node)
+            {
+                auto next = node->m_next;
+                ::operator delete(node);
+                node = next;
+            }
+        }
+    }
+
+    FreeNode* m_free[s_numClasses] {};
+    std::size_t m_cachedBytes[s_numClasses] {};
+};
+
+template<class T>
+struct thread_pool_allocator
+{
+    using value_type = T;
+
+    thread_pool_allocator() noexcept = default;
+
+    template<class U>
+    thread_pool_allocator(const thread_pool_allocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return (T*) ::operator new(n*sizeof(T), std::align_val_t{alignof(T)});
+        else if (auto pool = thread_pool::local())
+            return (T*) pool->allocate(n*sizeof(T));
+        else // the pool of this thread is gone, but the block may still be freed into the cache of another thread
+            return (T*) ::operator new(thread_pool::blockBytes(n*sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(p, std::align_val_t{alignof(T)});
+        else if (auto pool = thread_pool::local())
+            pool->deallocate(p, n*sizeof(T));
+        else
+            ::operator delete(p);
+    }
+};
+
+template<class T, class U>
+bool operator==(const thread_pool_allocator<T>&, const thread_pool_allocator<U>&) { return true; }
+
+template<class T, class U>
+bool operator!=(const thread_pool_allocator<T>&, const thread_pool_allocator<U>&) { return false; }
+
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "mco.hpp"
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace xtd
+{
+
+// As the first template argument of contiguous_ptr: every dynamic section has the same
+// number of elements, so the header stores a single count
+struct same_extent_t {};
+
+template<class... Sections>
+struct SectionList {};
+
+// The counts of the dynamic sections are kept in a std::size_t[H] section in front of the
+// user sections. Layouts with only static sections have no header at all.
+template<std::size_t H, class... Sections>
+struct WithHeader { using type = SectionList<std::size_t[H], Sections...>; };
+
+template<class... Sections>
+struct WithHeader<0, Sections...> { using type = SectionList<Sections...>; };
+
+template<bool SharedExtent, class List, class... Sections>
+struct ContiguousPtrBase;
+
+template<bool SharedExtent, class... Full, class... Sections>
+struct ContiguousPtrBase<SharedExtent, SectionList<Full...>, Sections...>
+{
+    static constexpr std::size_t s_numDynamic = numDynamicSections<Sections...>;
+    static constexpr std::size_t s_numCounts = s_numDynamic == 0 ? 0 : SharedExtent ? 1 : s_numDynamic;
+    static constexpr std::size_t s_first = s_numCounts ? 1 : 0; // index of the first user section in Full
+
+    template<std::size_t J>
+    using FullTraits = SectionTraits<std::tuple_element_t<J, std::tuple<Full...>>>;
+
+    ContiguousPtrBase() = default;
+    explicit ContiguousPtrBase(std::byte* block) : m_block(block) {}
+    ContiguousPtrBase(ContiguousPtrBase&& other) noexcept : m_block(std::exchange(other.m_block, nullptr)) {}
+
+    ContiguousPtrBase& operator=(ContiguousPtrBase&& other) noexcept
+    {
+        reset();
+        m_block = std::exchange(other.m_block, nullptr);
+        return *this;
+    }
+
+    ~ContiguousPtrBase() { reset(); }
+
+    void reset()
+    {
+        if (m_block)
+            destroy_contiguous_objects(layout());
+        m_block = nullptr;
+    }
+
+    // Gives up ownership, the block must then be destroyed through layout()
+    std::byte* release() { return std::exchange(m_block, nullptr); }
+
+    std::byte* get() const { return m_block; }
+    explicit operator bool() const { return m_block != nullptr; }
+
+    // Number of elements of section I
+    template<std::size_t I>
+    std::size_t size() const { return countOf<I + s_first>(); }
+
+    // Span over section I, computed from the block pointer and the header
+    template<std::size_t I>
+    auto section() const { return fullSection<I + s_first>(); }
+
+    // Every section, header included, as returned by make_contiguous_objects
+    auto layout() const { return layout(std::index_sequence_for<Full...>{}); }
+
+    template<std::size_t... J>
+    auto layout(std::index_sequence<J...>) const { return std::make_tuple(fullSection<J>()...); }
+
+    template<std::size_t J>
+    std::size_t countOf() const
+    {
+        if constexpr (FullTraits<J>::extent != dynamic_extent)
+            return FullTraits<J>::extent;
+        else if constexpr (SharedExtent)
+            return reinterpret_cast<const std::size_t*>(m_block)[0];
+        else
+            return reinterpret_cast<const std::size_t*>(m_block)[numDynamicSectionsBefore<J, Full...>()];
+    }
+
+    template<std::size_t J>
+    auto fullSection() const
+    {
+        using T = typename FullTraits<J>::type;
+        auto begin = reinterpret_cast<T*>(m_block + offsetOf<J>());
+        if constexpr (FullTraits<J>::extent != dynamic_extent)
+            return span<T, FullTraits<J>::extent>{begin};
+        else
+            return span<T>{begin, begin + countOf<J>()};
+    }
+
+    // Constant while every section before J has a static extent, then walks the dynamic ones
+    template<std::size_t J>
+    std::size_t offsetOf() const
+    {
+        if constexpr (numDynamicSectionsBefore<J, Full...>() == 0)
+            return static_offset<J, Full...>();
+        else
+            return advance<firstDynamic(), J>(static_offset<firstDynamic(), Full...>());
+    }
+
+    static constexpr std::size_t firstDynamic()
+    {
+        constexpr std::size_t extents[] = {SectionTraits<Full>::extent...};
+        std::size_t j = 0;
+        while (extents[j] != dynamic_extent)
+            ++j;
+        return j;
+    }
+
+    template<std::size_t J, std::size_t End>
+    std::size_t advance(std::size_t pos) const
+    {
+        if constexpr (J == End)
+            return pos;
+        else
+        {
+            pos += countOf<J>()*sizeof(typename FullTraits<J>::type);
+            pos += findDistanceOfNextAlignedPosition(pos, alignof(typename FullTraits<J + 1>::type));
+            return advance<J + 1, End>(pos);
+        }
+    }
+
+    template<class... Initializers>
+    static std::byte* make(Initializers... args)
+    {
+        if constexpr (sizeof...(Initializers) != sizeof...(Sections))
+        {
+            return completeInitializers<Sections...>([] (auto... inits) { return make(inits...); },
+                                                     std::index_sequence_for<Sections...>{}, args...);
+        }
+        else
+        {
+            // offsetOf() only knows the natural alignment of each section
+            static_assert((!IsAlignedInitializer<Initializers>::value && ...), "alignment modifiers are not supported");
+
+            std::array<std::size_t, s_numDynamic> counts {};
+            std::size_t i = 0;
+            ((SectionTraits<Sections>::extent == dynamic_extent ? void(counts[i++] = get_size(args)) : void()), ...);
+
+            if constexpr (s_numCounts == 0)
+            {
+                return (std::byte*)layoutBegin(make_contiguous_objects<Full...>(args...));
+            }
+            else
+            {
+                if constexpr (SharedExtent)
+                    for (auto c : counts)
+                        if (c != counts[0])
+                            throw std::length_error("same_extent_t requires every dynamic section to have the same count");
+
+                return (std::byte*)layoutBegin(make_contiguous_objects<Full...>(
+                    arg(input_iterator, s_numCounts, counts.begin()), args...));
+            }
+        }
+    }
+
+    std::byte* m_block {nullptr};
+};
+
+template<bool SharedExtent, class... Sections>
+using ContiguousPtrBaseFor = ContiguousPtrBase<
+    SharedExtent,
+    typename WithHeader<numDynamicSections<Sections...> == 0 ? 0 : SharedExtent ? 1 : numDynamicSections<Sections...>, Sections...>::type,
+    Sections...>;
+
+// Owning handle to a contiguous layout that is exactly one pointer wide.
+// Spans are recomputed on demand from the block pointer and the counts stored in the block.
+template<class... Sections>
+struct contiguous_ptr : ContiguousPtrBaseFor<false, Sections...>
+{
+    using Base = ContiguousPtrBaseFor<false, Sections...>;
+    using Base::Base;
+};
+
+template<class... Sections>
+struct contiguous_ptr<same_extent_t, Sections...> : ContiguousPtrBaseFor<true, Sections...>
+{
+    using Base = ContiguousPtrBaseFor<true, Sections...>;
+    using Base::Base;
+};
+
+// Initializers follow make_contiguous_objects: one per section, or one per dynamic section.
+// Alignment modifiers are not supported, sections are placed at their natural alignment.
+template<class... Sections, class... Initializers>
+contiguous_ptr<Sections...> make_contiguous_ptr(Initializers... args)
+{
+    return contiguous_ptr<Sections...>(contiguous_ptr<Sections...>::make(args...));
+}
+
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "mco.hpp"
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace xtd
+{
+
+// Section of a layout only known at runtime
+struct column_descriptor
+{
+    std::size_t m_size;
+    std::size_t m_alignment;
+    std::size_t m_count;
+    // Constructs count elements, destroying the ones already built if one throws. Null leaves the column uninitialized.
+    void (*m_construct)(void* begin, std::size_t count);
+    // Destroys count elements in reverse order. Null when there is nothing to destroy.
+    void (*m_destroy)(void* begin, std::size_t count);
+    // Checked by the typed views, null for columns that have no C++ type
+    const std::type_info* m_type;
+};
+
+template<class T, class Command>
+void constructColumn(void* begin, std::size_t count)
+{
+    std::tuple<span<T>> t {{(T*)begin, (T*)begin + count}};
+    if constexpr (std::is_same_v<Command, uninit_t>)
+        initRanges(t, arg(uninit, count));
+    else
+        initRanges(t, arg(count));
+}
+
+template<class T>
+void destroyColumn(void* begin, std::size_t count)
+{
+    reverse_destroy((T*)begin, (T*)begin + count);
+}
+
+// count value-initialized elements of T, as make_contiguous_objects<T[]>(count)
+template<class T>
+column_descriptor make_column_descriptor(std::size_t count)
+{
+    return {sizeof(T), alignof(T), count, &constructColumn<T, ctor_t>,
+            std::is_trivially_destructible_v<T> ? nullptr : &destroyColumn<T>, &typeid(T)};
+}
+
+// count default-initialized elements of T, as arg(uninit, count)
+template<class T>
+column_descriptor make_column_descriptor(uninit_t, std::size_t count)
+{
+    return {sizeof(T), alignof(T), count, std::is_trivially_default_constructible_v<T> ? nullptr : &constructColumn<T, uninit_t>,
+            std::is_trivially_destructible_v<T> ? nullptr : &destroyColumn<T>, &typeid(T)};
+}
+
+// Elements of one column of a runtime layout, converted to a typed span by as<T>()
+struct column_view
+{
+    template<class T>
+    span<T> as() const
+    {
+        if (m_column->m_type ? *m_column->m_type != typeid(T)
+                             : (sizeof(T) != m_column->m_size || alignof(T) > m_column->m_alignment || !std::is_trivially_copyable_v<T>))
+            throw std::bad_cast();
+        return {(T*)m_begin, (T*)m_begin + m_column->m_count};
+    }
+
+    std::size_t size() const { return m_column->m_count; }
+
+    void* m_begin;
+    const column_descriptor* m_column;
+};
+
+struct layout_descriptor;
+
+// Block built from a layout_descriptor, which must outlive it
+struct runtime_layout
+{
+    column_view column(std::size_t i) const;
+
+    std::byte* m_block;
+    const layout_descriptor* m_descriptor;
+};
+
+// Offsets of the columns, computed in one pass in declaration order with the same rules as
+// make_contiguous_objects: a block made from the descriptor of Args... is byte for byte the one
+// make_contiguous_objects<Args[]...> would make, and can be converted back and forth.
+struct layout_descriptor
+{
+    explicit layout_descriptor(std::vector<column_descriptor> columns) : m_columns(std::move(columns)), m_offsets(m_columns.size())
+    {
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < m_columns.size(); ++i)
+        {
+            auto& c = m_columns[i];
+            if (!c.m_alignment || (c.m_alignment & (c.m_alignment - 1)) || c.m_size % c.m_alignment)
+                throw std::invalid_argument("layout_descriptor: invalid alignment");
+            pos += findDistanceOfNextAlignedPosition(pos, c.m_alignment);
+            m_offsets[i] = pos;
+            pos += c.m_size*c.m_count;
+            m_alignment = std::max(m_alignment, c.m_alignment);
+        }
+        m_numBytes = pos;
+    }
+
+    std::size_t num_columns() const { return m_columns.size(); }
+    const column_descriptor& column(std::size_t i) const { return m_columns[i]; }
+    std::size_t offset(std::size_t i) const { return m_offsets[i]; }
+    std::size_t num_bytes() const { return m_numBytes; }
+    std::size_t alignment() const { return m_alignment; }
+
+    // Same choice of ::operator new overload as allocateBlock<Align>, so blocks can be freed by either path
+    std::byte* allocate() const
+    {
+        auto block = (std::byte*)(m_alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? ::operator new(m_numBytes, std::align_val_t{m_alignment})
+                                                                               : ::operator new(m_numBytes));
+        MCO_HOOK(m_onBlockAllocate, m_numBytes);
+        return block;
+    }
+
+    void deallocate(std::byte* block) const
+    {
+        MCO_HOOK(m_onBlockDeallocate);
+        if (m_alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(block, std::align_val_t{m_alignment});
+        else
+            ::operator delete(block);
+    }
+
+    void destroyColumns(std::byte* block, std::size_t numColumns) const
+    {
+        for (auto i = numColumns; i-- > 0;)
+            if (auto destroy = m_columns[i].m_destroy)
+                destroy(block + m_offsets[i], m_columns[i].m_count);
+    }
+
+    std::vector<column_descriptor> m_columns;
+    std::vector<std::size_t> m_offsets;
+    std::size_t m_numBytes {0};
+    std::size_t m_alignment {1};
+};
+
+inline column_view runtime_layout::column(std::size_t i) const
+{
+    return {m_block + m_descriptor->offset(i), &m_descriptor->column(i)};
+}
+
+struct RuntimeLayoutGuard
+{
+    ~RuntimeLayoutGuard()
+    {
+        if (m_block)
+        {
+            m_descriptor.destroyColumns(m_block, m_done);
+            m_descriptor.deallocate(m_block);
+        }
+    }
+
+    const layout_descriptor& m_descriptor;
+    std::byte* m_block;
+    std::size_t m_done {0};
+};
+
+// One allocation, columns constructed in declaration order. If a constructor throws, the columns
+// already built are destroyed in reverse order and the block is freed.
+inline runtime_layout make_contiguous_objects(const layout_descriptor& desc)
+{
+    RuntimeLayoutGuard g{desc, desc.allocate()};
+    for (; g.m_done < desc.num_columns(); ++g.m_done)
+    {
+        auto& c = desc.column(g.m_done);
+        if (c.m_construct)
+            c.m_construct(g.m_block + desc.offset(g.m_done), c.m_count);
+    }
+
+    auto block = std::exchange(g.m_block, nullptr);
+    return {block, &desc};
+}
+
+inline void destroy_contiguous_objects(const runtime_layout& l)
+{
+    l.m_descriptor->destroyColumns(l.m_block, l.m_descriptor->num_columns());
+    l.m_descriptor->deallocate(l.m_block);
+}
+
+// Typed view of a runtime layout, throws std::bad_cast when the columns don't hold Ts...
+// The result can be destroyed with destroy_contiguous_objects instead of the runtime layout: untyped
+// columns must be aligned exactly as Ts, for the block to be freed with the same ::operator delete.
+template<class... Ts, std::size_t... I>
+auto layoutCast(const runtime_layout& l, std::index_sequence<I...>) -> std::tuple<span<Ts>...>
+{
+    if (l.m_descriptor->num_columns() != sizeof...(Ts) || ((l.m_descriptor->column(I).m_alignment != alignof(Ts)) || ...))
+        throw std::bad_cast();
+    return {l.column(I).template as<Ts>()...};
+}
+
+template<class... Ts>
+auto layout_cast(const runtime_layout& l) -> std::tuple<span<Ts>...>
+{
+    return layoutCast<Ts...>(l, std::index_sequence_for<Ts...>{});
+}
+
+// Runtime view of a layout made by make_contiguous_objects, throws std::bad_cast when desc doesn't describe it
+template<class... Spans>
+runtime_layout as_runtime_layout(const layout_descriptor& desc, const std::tuple<Spans...>& t)
+{
+    auto block = layoutBegin(t);
+    if (desc.num_columns() != sizeof...(Spans) || desc.alignment() != blockAlignment<Spans...>)
+        throw std::bad_cast();
+
+    std::size_t i = 0;
+    auto check = [&] (auto& rng) {
+        using T = typename std::remove_reference_t<decltype(rng)>::type;
+        auto& c = desc.column(i);
+        bool matches = (c.m_type ? *c.m_type == typeid(T) : c.m_size == sizeof(T) && c.m_alignment == alignof(T)) && c.m_count == rng.size() &&
+            desc.offset(i) == std::size_t((std::byte*)rng.begin() - block);
+        ++i;
+        return matches;
+    };
+    if (!std::apply([&] (auto&... rngs) { return (check(rngs) && ...); }, t))
+        throw std::bad_cast();
+
+    return {block, &desc};
+}
+
+}
@@ -0,0 +1,310 @@
+#pragma once
+
+#include "mco.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace xtd
+{
+
+// File image of a layout: a header, one descriptor per section, then the block itself starting
+// on a page boundary so every section keeps its alignment once mapped.
+struct FileHeader
+{
+    char m_magic[8];
+    std::uint32_t m_byteOrder;       // s_byteOrder as stored by the machine that saved the file
+    std::uint32_t m_version;
+    std::uint64_t m_numSections;
+    std::uint64_t m_dataOffset;
+    std::uint64_t m_dataBytes;
+    std::uint64_t m_dataChecksum;
+    std::uint64_t m_headerChecksum;  // of the header, with this field at 0, and of the descriptors
+
+    static constexpr char s_magic[8] = {'x', 't', 'd', 'm', 'c', 'o', '\0', '\0'};
+    static constexpr std::uint32_t s_byteOrder = 0x01020304;
+    static constexpr std::uint32_t s_version = 2;
+};
+
+struct SectionDescriptor
+{
+    std::uint64_t m_count;
+    std::uint64_t m_offset;          // from the start of the block
+    std::uint64_t m_typeTag;         // section_type_tag of the element type
+    std::uint32_t m_elementSize;
+    std::uint32_t m_alignment;
+};
+
+static_assert(std::is_trivially_copyable_v<FileHeader> && std::is_trivially_copyable_v<SectionDescriptor>);
+
+template<std::size_t N>
+constexpr std::size_t fileDataOffset()
+{
+    auto bytes = sizeof(FileHeader) + N*sizeof(SectionDescriptor);
+    return bytes + findDistanceOfNextAlignedPosition(bytes, page_size);
+}
+
+// FNV-1a over 8 byte words, a byte at a time for the tail
+inline std::uint64_t checksum(const std::byte* data, std::size_t numBytes, std::uint64_t h = 0xcbf29ce484222325)
+{
+    constexpr std::uint64_t prime = 0x100000001b3;
+    std::size_t i = 0;
+    for (; i + 8 <= numBytes; i += 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, data + i, 8);
+        h = (h ^ w)*prime;
+    }
+    for (; i < numBytes; ++i)
+        h = (h ^ std::uint64_t(data[i]))*prime;
+    return h;
+}
+
+// Stable hash of a type name, for specializations of section_type_tag
+constexpr std::uint64_t type_tag(const char* name)
+{
+    std::uint64_t h = 0xcbf29ce484222325;
+    for (; *name; ++name)
+        h = (h ^ std::uint64_t((unsigned char)*name))*0x100000001b3;
+    return h;
+}
+
+// Identifies the element type of a section, so files can't be mapped with types of the same size in
+// another order. Defaults to the name of typeid(T), which only stays the same for one compiler ABI:
+// specialize it with type_tag("some name") for files exchanged between toolchains.
+template<class T>
+struct section_type_tag
+{
+    static std::uint64_t value() { return type_tag(typeid(T).name()); }
+};
+
+inline std::uint64_t headerChecksum(FileHeader header, const SectionDescriptor* sections)
+{
+    header.m_headerChecksum = 0;
+    auto h = checksum((const std::byte*)&header, sizeof(header));
+    return checksum((const std::byte*)sections, header.m_numSections*sizeof(SectionDescriptor), h);
+}
+
+inline void writeAll(int fd, const std::byte* data, std::size_t numBytes)
+{
+    while (numBytes)
+    {
+        auto n = ::write(fd, data, numBytes);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            throw std::system_error(errno, std::generic_category(), "save_contiguous_objects");
+        data += n;
+        numBytes -= n;
+    }
+}
+
+struct SectionBytes
+{
+    std::size_t m_offset;
+    std::size_t m_numBytes;
+};
+
+// Calls fn with the block as it is stored, in chunks of a multiple of 8 bytes so checksums can be chained:
+// the bytes of the sections, zeros for the padding between them, which was never initialized.
+template<std::size_t N, class Fn>
+void forEachStoredChunk(const std::byte* block, std::size_t numBytes, const SectionBytes (&sections)[N], Fn&& fn)
+{
+    constexpr std::size_t chunkBytes = 64*1024;
+    std::vector<std::byte> chunk(std::min(numBytes, chunkBytes));
+    for (std::size_t pos = 0; pos < numBytes; pos += chunkBytes)
+    {
+        auto end = std::min(pos + chunkBytes, numBytes);
+        std::fill(chunk.begin(), chunk.end(), std::byte(0));
+        for (auto& s : sections)
+        {
+            auto b = std::max(s.m_offset, pos);
+            auto e = std::min(s.m_offset + s.m_numBytes, end);
+            if (b < e)
+                std::memcpy(chunk.data() + (b - pos), block + b, e - b);
+        }
+        fn(chunk.data(), end - pos);
+    }
+}
+
+template<class... Spans, std::size_t... I>
+void saveObjects(int fd, const std::tuple<Spans...>& t, std::index_sequence<I...>)
+{
+    static_assert((std::is_trivially_copyable_v<typename Spans::type> && ...), "sections must be trivially copyable");
+    static_assert(blockAlignment<Spans...> <= page_size, "sections can't be aligned beyond a page");
+
+    constexpr auto dataOffset = fileDataOffset<sizeof...(Spans)>();
+    std::vector<std::byte> head(dataOffset);
+    auto block = layoutBegin(t);
+
+    FileHeader header {};
+    std::memcpy(header.m_magic, FileHeader::s_magic, sizeof(header.m_magic));
+    header.m_byteOrder = FileHeader::s_byteOrder;
+    header.m_version = FileHeader::s_version;
+    header.m_numSections = sizeof...(Spans);
+    header.m_dataOffset = dataOffset;
+    header.m_dataBytes = numLayoutBytes(t);
+
+    SectionBytes stored[] = {SectionBytes{
+        std::size_t((std::byte*)std::get<I>(t).begin() - block),
+        std::size_t((std::byte*)std::get<I>(t).end() - (std::byte*)std::get<I>(t).begin())}...};
+    header.m_dataChecksum = checksum(nullptr, 0); // chained over the chunks
+    forEachStoredChunk(block, header.m_dataBytes, stored, [&] (const std::byte* data, std::size_t numBytes) {
+        header.m_dataChecksum = checksum(data, numBytes, header.m_dataChecksum);
+    });
+
+    SectionDescriptor sections[] = {SectionDescriptor{
+        std::uint64_t(std::get<I>(t).end() - std::get<I>(t).begin()),
+        std::uint64_t((std::byte*)std::get<I>(t).begin() - block),
+        section_type_tag<std::remove_cv_t<typename Spans::type>>::value(),
+        sizeof(typename Spans::type),
+        Spans::alignment}...};
+    header.m_headerChecksum = headerChecksum(header, sections);
+
+    std::memcpy(head.data(), &header, sizeof(header));
+    std::memcpy(head.data() + sizeof(header), sections, sizeof(sections));
+    writeAll(fd, head.data(), head.size());
+    forEachStoredChunk(block, header.m_dataBytes, stored, [&] (const std::byte* data, std::size_t numBytes) {
+        writeAll(fd, data, numBytes);
+    });
+}
+
+// Writes the layout to fd, at its current position. Sections must be trivially copyable and
+// should not hold pointers, they are stored as is and the padding between them as zeros.
+template<class... Spans>
+void save_contiguous_objects(int fd, const std::tuple<Spans...>& t)
+{
+    saveObjects(fd, t, std::index_sequence_for<Spans...>{});
+}
+
+struct skip_checksum_t{}; static constexpr skip_checksum_t skip_checksum;
+
+struct MappingGuard
+{
+    ~MappingGuard() { if (m_base) ::munmap(m_base, m_numBytes); }
+    void release() { m_base = nullptr; }
+    void* m_base;
+    std::size_t m_numBytes;
+};
+
+template<class S>
+using mapped_span = span<const typename SectionTraits<S>::type, SectionTraits<S>::extent>;
+
+template<class... Args, std::size_t... I>
+auto mapObjects(const char* path, bool verifyData, std::index_sequence<I...>) -> std::tuple<mapped_span<Args>...>
+{
+    auto fail = [] (const char* what) { throw std::runtime_error(std::string("map_contiguous_objects: ") + what); };
+
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "map_contiguous_objects");
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), "map_contiguous_objects");
+    }
+    if (st.st_size == 0)
+    {
+        ::close(fd);
+        throw std::system_error(EINVAL, std::generic_category(), "map_contiguous_objects");
+    }
+
+    std::size_t fileBytes = st.st_size;
+    void* base = ::mmap(nullptr, fileBytes, PROT_READ, MAP_SHARED, fd, 0);
+    int err = errno;
+    ::close(fd);
+    if (base == MAP_FAILED)
+        throw std::system_error(err, std::generic_category(), "map_contiguous_objects");
+    MappingGuard mg{base, fileBytes};
+
+    constexpr auto dataOffset = fileDataOffset<sizeof...(Args)>();
+    if (fileBytes < dataOffset)
+        fail("truncated header");
+
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    auto sections = (const SectionDescriptor*)((const std::byte*)base + sizeof(header));
+
+    if (std::memcmp(header.m_magic, FileHeader::s_magic, sizeof(header.m_magic)) != 0)
+        fail("not a layout file");
+    if (header.m_byteOrder != FileHeader::s_byteOrder)
+        fail("saved with a different byte order");
+    if (header.m_version != FileHeader::s_version)
+        fail("unsupported version");
+    if (header.m_numSections != sizeof...(Args))
+        fail("wrong number of sections");
+    if (header.m_headerChecksum != headerChecksum(header, sections))
+        fail("corrupted header");
+    if (header.m_dataOffset != dataOffset || header.m_dataBytes != fileBytes - dataOffset)
+        fail("wrong file size");
+
+    auto data = (const std::byte*)base + dataOffset;
+    auto checkSection = [&] (const SectionDescriptor& s, std::uint64_t tag, std::size_t size, std::size_t align, std::size_t extent) {
+        if (s.m_typeTag != tag || s.m_elementSize != size || s.m_alignment < align || s.m_offset % align != 0)
+            fail("section type mismatch");
+        if (extent != dynamic_extent && s.m_count != extent)
+            fail("static extent mismatch");
+        if (s.m_offset > header.m_dataBytes || s.m_count > (header.m_dataBytes - s.m_offset)/size)
+            fail("section out of bounds");
+    };
+    (checkSection(sections[I], section_type_tag<std::remove_cv_t<typename SectionTraits<Args>::type>>::value(),
+                  sizeof(typename SectionTraits<Args>::type), alignof(typename SectionTraits<Args>::type),
+                  SectionTraits<Args>::extent), ...);
+
+    if (verifyData && header.m_dataChecksum != checksum(data, header.m_dataBytes))
+        fail("corrupted data");
+
+    std::tuple<mapped_span<Args>...> r;
+    auto setSpan = [&] (auto& rng, const SectionDescriptor& s) {
+        using T = typename std::remove_reference_t<decltype(rng)>::type;
+        rng.m_begin = reinterpret_cast<T*>(data + s.m_offset);
+        if constexpr (std::remove_reference_t<decltype(rng)>::extent == dynamic_extent)
+            rng.m_end = rng.m_begin + s.m_count;
+    };
+    (setSpan(std::get<I>(r), sections[I]), ...);
+
+    mg.release();
+    return r;
+}
+
+// Maps a file written by save_contiguous_objects read-only and returns its sections without copying them.
+// Args must match the types the file was saved with. Pages are shared with every process mapping the same file.
+// Skipping the checksum avoids reading the whole file up front.
+template<class... Args>
+auto map_contiguous_objects(const char* path) -> std::tuple<mapped_span<Args>...>
+{
+    return mapObjects<Args...>(path, true, std::index_sequence_for<Args...>{});
+}
+
+template<class... Args>
+auto map_contiguous_objects(const char* path, skip_checksum_t) -> std::tuple<mapped_span<Args>...>
+{
+    return mapObjects<Args...>(path, false, std::index_sequence_for<Args...>{});
+}
+
+template<class... Spans>
+void unmap_contiguous_objects(const std::tuple<Spans...>& t)
+{
+    constexpr auto dataOffset = fileDataOffset<sizeof...(Spans)>();
+    ::munmap(layoutBegin(t) - dataOffset, dataOffset + numLayoutBytes(t));
+}
+
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "mco.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace xtd
+{
+
+// Execution policy of the parallel overloads. With m_numThreads at 0, every hardware thread is used.
+struct parallel_t { unsigned m_numThreads {0}; };
+static constexpr parallel_t par {};
+
+// Sections smaller than this are constructed by a single thread
+static constexpr std::size_t parallel_min_chunk_bytes = std::size_t(1) << 16;
+
+template<class Config>
+struct IsSplittable : std::true_type {};
+
+// Each thread starts reading at its own offset, which needs random access
+template<class It>
+struct IsSplittable<InitializerConfiguration<input_iterator_t, It>>
+    : std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category> {};
+
+// Records how many elements of a chunk were constructed, even when leaving with an exception
+struct ChunkGuard
+{
+    ~ChunkGuard() { m_out = m_done; }
+    std::size_t& m_out;
+    std::size_t m_done {0};
+};
+
+// Every thread constructs its chunk of every section. Chunk boundaries fall on page boundaries,
+// so each page is first touched, and thus placed, by the thread that constructs it.
+// Constructed elements are only destroyed once all threads are done: chunks are then
+// rolled back from the last one to the first one, which is the reverse order of addresses.
+template<class Layout, class Inits>
+struct ParallelConstruction
+{
+    static constexpr std::size_t s_numSections = std::tuple_size_v<Layout>;
+
+    ParallelConstruction(Layout& layout, Inits& inits, std::size_t numChunks)
+        : m_layout(layout), m_inits(inits), m_numChunks(numChunks),
+          m_done(s_numSections*numChunks, 0), m_errors(numChunks) {}
+
+    template<std::size_t I>
+    std::pair<std::size_t, std::size_t> bounds(std::size_t k) const
+    {
+        auto& rng = std::get<I>(m_layout);
+        using T = typename std::remove_reference_t<decltype(rng)>::type;
+        using Config = std::tuple_element_t<I, Inits>;
+        std::size_t count = rng.end() - rng.begin();
+
+        if (!IsSplittable<Config>::value || m_numChunks == 1 || count*sizeof(T) < 2*parallel_min_chunk_bytes)
+            return k == 0 ? std::make_pair(std::size_t(0), count) : std::make_pair(count, count);
+
+        auto boundary = [&] (std::size_t j) {
+            if (j == 0 || j == m_numChunks)
+                return j == 0 ? std::size_t(0) : count;
+            auto base = (std::uintptr_t)rng.begin();
+            auto addr = base + count*sizeof(T)/m_numChunks*j;
+            addr += findDistanceOfNextAlignedPosition(addr, page_size);
+            return std::min(count, (addr - base + sizeof(T) - 1)/sizeof(T));
+        };
+        return {boundary(k), boundary(k + 1)};
+    }
+
+    template<std::size_t I>
+    void constructChunk(std::size_t k)
+    {
+        if (m_failed.load(std::memory_order_relaxed))
+            return;
+
+        auto& rng = std::get<I>(m_layout);
+        using T = typename std::remove_reference_t<decltype(rng)>::type;
+        using DT = std::tuple_element_t<I, Inits>;
+        auto ac = std::get<I>(m_inits);
+        auto [b, e] = bounds<I>(k);
+
+        ChunkGuard g{m_done[I*m_numChunks + k]};
+
+        if constexpr (std::is_same_v<typename DT::command, input_iterator_t> && IsSplittable<DT>::value)
+            ac.m_args += b;
+
+        if constexpr (BulkInit<T, DT>::value)
+        {
+            span<T> chunk{rng.begin() + b, rng.begin() + e};
+            bulkInitialize(chunk, ac);
+            g.m_done = e - b;
+        }
+        else
+        {
+            for (auto p = rng.begin() + b; p != rng.begin() + e; ++p, ++g.m_done)
+            {
+                if (m_failed.load(std::memory_order_relaxed))
+                    return;
+
+                if constexpr (std::is_same_v<typename DT::command, uninit_t>)
+                    new (p) T;
+
+                if constexpr (std::is_same_v<typename DT::command, ctor_t>)
+                    std::apply([&] (auto&&... args) { new (p) T(args...); }, ac.m_args);
+
+                if constexpr (std::is_same_v<typename DT::command, aggregate_t>)
+                    std::apply([&] (auto&&... args) { new (p) T{args...}; }, ac.m_args);
+
+                if constexpr (std::is_same_v<typename DT::command, input_iterator_t>)
+                    new (p) T(*ac.m_args++);
+
+                if constexpr (std::is_same_v<typename DT::command, functor_t>)
+                    new (p) T(ac.m_args());
+            }
+        }
+    }
+
+    template<std::size_t... I>
+    void constructChunks(std::size_t k, std::index_sequence<I...>)
+    {
+        (constructChunk<I>(k), ...);
+    }
+
+    void runChunk(std::size_t k)
+    {
+        try
+        {
+            constructChunks(k, std::make_index_sequence<s_numSections>{});
+        }
+        catch (...)
+        {
+            m_errors[k] = std::current_exception();
+            m_failed = true;
+        }
+    }
+
+    template<std::size_t I>
+    void rollbackSection()
+    {
+        auto& rng = std::get<I>(m_layout);
+        for (std::size_t k = m_numChunks; k-- > 0;)
+        {
+            auto b = bounds<I>(k).first;
+            reverse_destroy(rng.begin() + b, rng.begin() + b + m_done[I*m_numChunks + k]);
+        }
+    }
+
+    template<std::size_t... I>
+    void rollback(std::index_sequence<I...>)
+    {
+        (rollbackSection<s_numSections - 1 - I>(), ...);
+    }
+
+    void run()
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(m_numChunks - 1);
+        for (std::size_t k = 1; k < m_numChunks; ++k)
+        {
+            try
+            {
+                workers.emplace_back([this, k] { runChunk(k); });
+            }
+            catch (...)
+            {
+                m_errors[k] = std::current_exception();
+                m_failed = true;
+                break;
+            }
+        }
+
+        runChunk(0);
+        for (auto& w : workers)
+            w.join();
+
+        for (auto& e : m_errors)
+        {
+            if (e)
+            {
+                rollback(std::make_index_sequence<s_numSections>{});
+                std::rethrow_exception(e);
+            }
+        }
+    }
+
+    Layout& m_layout;
+    Inits& m_inits;
+    std::size_t m_numChunks;
+    std::vector<std::size_t> m_done; // per section, then per chunk
+    std::vector<std::exception_ptr> m_errors;
+    std::atomic<bool> m_failed {false};
+};
+
+template<class OrderPolicy, class... Args, class... Initializers>
+auto makeObjectsParallel(parallel_t policy, Initializers... args)
+{
+    if constexpr (sizeof...(Initializers) != sizeof...(Args))
+    {
+        return completeInitializers<Args...>([&] (auto... inits) { return makeObjectsParallel<OrderPolicy, Args...>(policy, inits...); },
+                                             std::index_sequence_for<Args...>{}, args...);
+    }
+    else
+    {
+        auto layout = makeLayout(OrderPolicy::template order<typename decltype(sectionSize<Args>(args))::span_type...>(),
+                                 sectionSize<Args>(args)...);
+        MemGuard<blockAlignment<typename decltype(sectionSize<Args>(args))::span_type...>> mg{layoutBegin(layout)};
+
+        std::size_t numChunks = policy.m_numThreads ? policy.m_numThreads : std::max(1u, std::thread::hardware_concurrency());
+        if (numLayoutBytes(layout) < 2*parallel_min_chunk_bytes)
+            numChunks = 1;
+
+        auto inits = std::make_tuple(convert_arg(args)...);
+        ParallelConstruction<decltype(layout), decltype(inits)>(layout, inits, numChunks).run();
+
+        mg.release();
+        return layout;
+    }
+}
+
+// Same as make_contiguous_objects, but large sections are split in chunks constructed by several threads.
+// Initializers are shared by the threads: functors are called concurrently and must be thread-safe.
+template<class... Args, class... Initializers>
+auto make_contiguous_objects(parallel_t policy, Initializers... args)
+{
+    return makeObjectsParallel<DeclarationOrder, Args...>(policy, args...);
+}
+
+template<class... Args, class... Initializers>
+auto make_contiguous_objects_packed(parallel_t policy, Initializers... args)
+{
+    return makeObjectsParallel<PackedOrder, Args...>(policy, args...);
+}
+
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "mco.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace xtd
+{
+
+struct pool_options
+{
+    std::size_t m_slotsPerSlab {256};
+    // At 0 the pool takes no lock and must only be used by one thread at a time. Otherwise it is
+    // thread-safe and each thread keeps the slots it frees in one of m_numThreadCaches caches.
+    unsigned m_numThreadCaches {0};
+};
+
+// Intrusive free list node, written over the first bytes of a free slot
+struct PoolSlot { PoolSlot* m_next; };
+
+// Fixed size slots carved from slabs, freed slots are reused first
+template<std::size_t Align>
+struct SlotStore
+{
+    SlotStore(std::size_t slotBytes, std::size_t slotsPerSlab) : m_slotBytes(slotBytes), m_slotsPerSlab(slotsPerSlab) {}
+
+    SlotStore(const SlotStore&) = delete;
+    SlotStore& operator=(const SlotStore&) = delete;
+
+    ~SlotStore()
+    {
+        for (auto slab : m_slabs)
+            deallocateBlock<Align>(slab);
+    }
+
+    void* take()
+    {
+        if (auto slot = m_free)
+        {
+            m_free = slot->m_next;
+            return slot;
+        }
+        if (m_next == m_end)
+            addSlab();
+        auto r = m_next;
+        m_next += m_slotBytes;
+        return r;
+    }
+
+    void give(void* p) noexcept
+    {
+        auto slot = (PoolSlot*)p;
+        slot->m_next = m_free;
+        m_free = slot;
+    }
+
+    void addSlab()
+    {
+        m_slabs.reserve(m_slabs.size() + 1);
+        auto slab = (std::byte*)allocateBlock<Align>(m_slotBytes*m_slotsPerSlab);
+        m_slabs.push_back(slab);
+        m_next = slab;
+        m_end = slab + m_slotBytes*m_slotsPerSlab;
+    }
+
+    std::size_t m_slotBytes;
+    std::size_t m_slotsPerSlab;
+    PoolSlot* m_free {nullptr};
+    std::byte* m_next {nullptr};
+    std::byte* m_end {nullptr};
+    std::vector<std::byte*> m_slabs;
+};
+
+struct ThreadCache
+{
+    std::mutex m_mutex;
+    PoolSlot* m_free {nullptr};
+    std::size_t m_count {0};
+};
+
+// Threads are spread over the caches in the order they first use a pool
+inline unsigned threadCacheIndex()
+{
+    static std::atomic<unsigned> next {0};
+    thread_local unsigned index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+// Instances of the same layout carved from large slabs instead of one ::operator new each.
+// The slot size is computed once from the largest count of every section, instances made with
+// smaller counts use the same slot. Layouts are identical to make_contiguous_objects<Args...>.
+// Instances must be given back with destroy() before the pool is destroyed.
+template<class... Args>
+struct contiguous_object_pool
+{
+    using Layout = std::tuple<span<typename SectionTraits<Args>::type, SectionTraits<Args>::extent>...>;
+    using Order = std::index_sequence_for<Args...>;
+
+    static constexpr std::size_t s_slotAlignment = std::max(blockAlignment<span<typename SectionTraits<Args>::type>...>, alignof(PoolSlot));
+    static constexpr std::size_t s_cacheBatch = 32; // slots moved at once between a thread cache and the pool
+
+    // One maximum count per section, or one per dynamic section
+    template<class... Counts>
+    explicit contiguous_object_pool(Counts... maxCounts) : contiguous_object_pool(pool_options{}, maxCounts...) {}
+
+    template<class... Counts>
+    contiguous_object_pool(pool_options options, Counts... maxCounts)
+        : m_maxCounts(resizedCounts<span<typename SectionTraits<Args>::type, SectionTraits<Args>::extent>...>(maxCounts...)),
+          m_store(slotBytes(m_maxCounts, Order{}), std::max<std::size_t>(options.m_slotsPerSlab, 1)),
+          m_numCaches(options.m_numThreadCaches),
+          m_caches(m_numCaches ? new ThreadCache[m_numCaches] : nullptr) {}
+
+    contiguous_object_pool(const contiguous_object_pool&) = delete;
+    contiguous_object_pool& operator=(const contiguous_object_pool&) = delete;
+
+    // Same initializers as make_contiguous_objects, counts can't exceed the maximums given to the pool.
+    // If a constructor throws, the objects already built are destroyed and the slot is given back.
+    template<class... Initializers>
+    Layout make(Initializers... args)
+    {
+        if constexpr (sizeof...(Initializers) != sizeof...(Args))
+        {
+            return completeInitializers<Args...>([this] (auto... inits) { return make(inits...); }, Order{}, args...);
+        }
+        else
+        {
+            static_assert(std::is_same_v<std::tuple<typename decltype(sectionSize<Args>(args))::span_type...>, Layout>,
+                          "alignment modifiers are not supported");
+
+            std::size_t counts[] = {get_size(args)...};
+            for (std::size_t i = 0; i < sizeof...(Args); ++i)
+                if (counts[i] > m_maxCounts[i])
+                    throw std::length_error("contiguous_object_pool: count exceeds the maximum of the pool");
+
+            SlotGuard g{*this, takeSlot()};
+            std::tuple<decltype(sectionSize<Args>(args))...> sizes {sectionSize<Args>(args)...};
+            auto layout = setRanges(Order{}, sizes, (std::byte*)g.m_slot);
+            MCO_HOOK(m_onLayout, typeid(Layout), (sectionSize<Args>(args).numBytes() + ... + 0),
+                     requiredBytes(Order{}, sizes) - (sectionSize<Args>(args).numBytes() + ... + 0));
+
+            {
+                MCO_TIMED_HOOK(m_onConstruct, typeid(Layout));
+                initRanges(layout, convert_arg(args)...);
+            }
+
+            g.m_slot = nullptr;
+            return layout;
+        }
+    }
+
+    // Not noexcept: with thread caches, giving the slot back locks a mutex, which may throw std::system_error.
+    // The objects are destroyed by then and only the slot is lost.
+    void destroy(const Layout& t)
+    {
+        {
+            MCO_TIMED_HOOK(m_onDestroy, typeid(Layout));
+            forEachReversed(t, [] (auto& rng) { reverse_destroy(rng.begin(), rng.end()); }, Order{});
+        }
+        // Sections are in declaration order, the first one starts the slot
+        giveSlot((void*)std::get<0>(t).begin());
+    }
+
+    std::size_t slot_bytes() const { return m_store.m_slotBytes; }
+    std::size_t num_slabs() const { return m_store.m_slabs.size(); }
+
+    template<std::size_t... I>
+    static std::size_t slotBytes(const std::array<std::size_t, sizeof...(Args)>& maxCounts, std::index_sequence<I...> order)
+    {
+        std::tuple<typename SpanSize<span<typename SectionTraits<Args>::type, SectionTraits<Args>::extent>>::type...> sizes {maxCounts[I]...};
+        auto numBytes = std::max(requiredBytes(order, sizes), sizeof(PoolSlot));
+        return numBytes + findDistanceOfNextAlignedPosition(numBytes, s_slotAlignment);
+    }
+
+    struct SlotGuard
+    {
+        // Runs while an exception is in flight: the slot is lost rather than terminating if giveSlot throws
+        ~SlotGuard()
+        {
+            if (m_slot)
+                try { m_pool.giveSlot(m_slot); } catch (...) {}
+        }
+        contiguous_object_pool& m_pool;
+        void* m_slot;
+    };
+
+    ThreadCache& localCache() { return m_caches[threadCacheIndex() % m_numCaches]; }
+
+    void* takeSlot()
+    {
+        if (!m_numCaches)
+            return m_store.take();
+
+        auto& cache = localCache();
+        std::lock_guard<std::mutex> lock(cache.m_mutex);
+        if (!cache.m_free)
+            refill(cache);
+
+        auto slot = cache.m_free;
+        cache.m_free = slot->m_next;
+        --cache.m_count;
+        return slot;
+    }
+
+    void giveSlot(void* p)
+    {
+        if (!m_numCaches)
+            return m_store.give(p);
+
+        auto& cache = localCache();
+        std::lock_guard<std::mutex> lock(cache.m_mutex);
+        auto slot = (PoolSlot*)p;
+        slot->m_next = cache.m_free;
+        cache.m_free = slot;
+        if (++cache.m_count >= 2*s_cacheBatch)
+            drain(cache);
+    }
+
+    // Moves a batch of slots from the pool to the cache, as many as could be taken when a slab can't be allocated
+    void refill(ThreadCache& cache)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        try
+        {
+            for (std::size_t i = 0; i < s_cacheBatch; ++i, ++cache.m_count)
+            {
+                auto slot = (PoolSlot*)m_store.take();
+                slot->m_next = cache.m_free;
+                cache.m_free = slot;
+            }
+        }
+        catch (...)
+        {
+            if (!cache.m_free)
+                throw;
+        }
+    }
+
+    void drain(ThreadCache& cache)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (; cache.m_count > s_cacheBatch; --cache.m_count)
+        {
+            auto slot = cache.m_free;
+            cache.m_free = slot->m_next;
+            m_store.give(slot);
+        }
+    }
+
+    std::array<std::size_t, sizeof...(Args)> m_maxCounts;
+    SlotStore<s_slotAlignment> m_store;
+    std::mutex m_mutex; // guards m_store when there are thread caches
+    unsigned m_numCaches;
+    std::unique_ptr<ThreadCache[]> m_caches;
+};
+
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "mco.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace xtd
+{
+
+// Placed in front of the elements. As for std::shared_ptr, the weak count includes one
+// reference held collectively by the strong references.
+struct SharedArrayControl
+{
+    explicit SharedArrayControl(std::size_t size) : m_size(size) {}
+
+    std::atomic<std::size_t> m_strong {1};
+    std::atomic<std::size_t> m_weak {1};
+    std::size_t m_size;
+};
+
+template<class T>
+using SharedArraySections = std::tuple<span<SharedArrayControl, 1>, span<T>>;
+
+template<class T>
+constexpr std::size_t sharedArrayOffset() { return static_offset<1, SharedArrayControl[1], T[]>(); }
+
+template<class T>
+T* sharedArrayData(SharedArrayControl* ctrl) { return reinterpret_cast<T*>((std::byte*)ctrl + sharedArrayOffset<T>()); }
+
+template<class T>
+void releaseWeak(SharedArrayControl* ctrl)
+{
+    if (ctrl->m_weak.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        auto data = sharedArrayData<T>(ctrl);
+        destroy_contiguous_objects(SharedArraySections<T>{{ctrl}, {data, data}});
+    }
+}
+
+template<class T>
+void releaseStrong(SharedArrayControl* ctrl)
+{
+    if (ctrl->m_strong.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        auto data = sharedArrayData<T>(ctrl);
+        reverse_destroy(data, data + ctrl->m_size);
+        releaseWeak<T>(ctrl);
+    }
+}
+
+template<class T>
+struct weak_array;
+
+// Reference counted array whose counts, size and elements share a single allocation.
+// The handle is one pointer wide, copies are thread-safe as for std::shared_ptr.
+template<class T>
+struct shared_array
+{
+    using element_type = T;
+
+    shared_array() = default;
+    explicit shared_array(SharedArrayControl* ctrl) : m_ctrl(ctrl) {}
+
+    shared_array(const shared_array& other) : m_ctrl(other.m_ctrl)
+    {
+        if (m_ctrl)
+            m_ctrl->m_strong.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shared_array(shared_array&& other) noexcept : m_ctrl(std::exchange(other.m_ctrl, nullptr)) {}
+
+    shared_array& operator=(shared_array other) noexcept
+    {
+        std::swap(m_ctrl, other.m_ctrl);
+        return *this;
+    }
+
+    ~shared_array() { reset(); }
+
+    void reset()
+    {
+        if (m_ctrl)
+            releaseStrong<T>(std::exchange(m_ctrl, nullptr));
+    }
+
+    T* data() const { return m_ctrl ? sharedArrayData<T>(m_ctrl) : nullptr; }
+    std::size_t size() const { return m_ctrl ? m_ctrl->m_size : 0; }
+    T* begin() const { return data(); }
+    T* end() const { return data() + size(); }
+    T& operator[](std::size_t i) const { return data()[i]; }
+
+    std::size_t use_count() const { return m_ctrl ? m_ctrl->m_strong.load(std::memory_order_relaxed) : 0; }
+    explicit operator bool() const { return m_ctrl != nullptr; }
+
+    SharedArrayControl* m_ctrl {nullptr};
+};
+
+template<class T>
+struct weak_array
+{
+    weak_array() = default;
+
+    weak_array(const shared_array<T>& shared) : m_ctrl(shared.m_ctrl)
+    {
+        if (m_ctrl)
+            m_ctrl->m_weak.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    weak_array(const weak_array& other) : m_ctrl(other.m_ctrl)
+    {
+        if (m_ctrl)
+            m_ctrl->m_weak.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    weak_array(weak_array&& other) noexcept : m_ctrl(std::exchange(other.m_ctrl, nullptr)) {}
+
+    weak_array& operator=(weak_array other) noexcept
+    {
+        std::swap(m_ctrl, other.m_ctrl);
+        return *this;
+    }
+
+    ~weak_array() { reset(); }
+
+    void reset()
+    {
+        if (m_ctrl)
+            releaseWeak<T>(std::exchange(m_ctrl, nullptr));
+    }
+
+    // Empty when every strong reference is gone
+    shared_array<T> lock() const
+    {
+        if (!m_ctrl)
+            return {};
+        auto strong = m_ctrl->m_strong.load(std::memory_order_relaxed);
+        while (strong && !m_ctrl->m_strong.compare_exchange_weak(strong, strong + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+            ;
+        return strong ? shared_array<T>(m_ctrl) : shared_array<T>();
+    }
+
+    bool expired() const { return use_count() == 0; }
+    std::size_t use_count() const { return m_ctrl ? m_ctrl->m_strong.load(std::memory_order_relaxed) : 0; }
+
+    SharedArrayControl* m_ctrl {nullptr};
+};
+
+// init is an element count (value-initialization) or any initializer of make_contiguous_objects:
+// arg(ctor, n, args...), arg(uninit, n), arg(functor, n, fn), arg(input_iterator, n, it)...
+// Alignment modifiers are not supported, the elements are placed at their natural alignment.
+template<class T, class Init>
+shared_array<T> make_shared_array(Init init)
+{
+    static_assert(!IsAlignedInitializer<Init>::value, "alignment modifiers are not supported");
+    auto t = make_contiguous_objects<SharedArrayControl[1], T[]>(arg(ctor, 1, get_size(init)), init);
+    return shared_array<T>(std::get<0>(t).begin());
+}
+
+// Same as std::make_shared_for_overwrite: trivially constructible elements are left uninitialized
+template<class T>
+shared_array<T> make_shared_array_for_overwrite(std::size_t count)
+{
+    return make_shared_array<T>(arg(uninit, count));
+}
+
+}
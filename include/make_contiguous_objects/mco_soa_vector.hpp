@@ -0,0 +1,353 @@
+#pragma once
+
+#include "mco.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace xtd
+{
+
+// Field of a soa_vector whose column starts on an Align boundary and is padded to a multiple of Align
+// bytes, so full width vector loads past the last element stay inside the block
+template<class T, std::size_t Align>
+struct aligned_column
+{
+    static_assert(Align && !(Align & (Align - 1)), "alignment must be a power of two");
+};
+
+template<class F>
+struct ColumnTraits
+{
+    using type = F;
+    using size_type = ArraySize<F>;
+};
+
+template<class T, std::size_t Align>
+struct ColumnTraits<aligned_column<T, Align>>
+{
+    using type = T;
+    using size_type = ArraySize<T, Align, Align>;
+};
+
+// Row-wise access to the columns, dereferences to a tuple of references
+template<class... Ts>
+struct soa_iterator
+{
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::tuple<std::remove_const_t<Ts>...>;
+    using reference = std::tuple<Ts&...>;
+    using pointer = void;
+
+    reference operator*() const { return std::apply([] (auto... p) { return reference(*p...); }, m_ptrs); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    soa_iterator& operator+=(difference_type n) { std::apply([n] (auto&... p) { ((p += n), ...); }, m_ptrs); return *this; }
+    soa_iterator& operator-=(difference_type n) { return *this += -n; }
+    soa_iterator& operator++() { return *this += 1; }
+    soa_iterator& operator--() { return *this += -1; }
+    soa_iterator operator++(int) { auto r = *this; ++*this; return r; }
+    soa_iterator operator--(int) { auto r = *this; --*this; return r; }
+    friend soa_iterator operator+(soa_iterator it, difference_type n) { return it += n; }
+    friend soa_iterator operator-(soa_iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const soa_iterator& a, const soa_iterator& b) { return std::get<0>(a.m_ptrs) - std::get<0>(b.m_ptrs); }
+
+    // Every column moves together, comparing the first one is enough
+    friend bool operator==(const soa_iterator& a, const soa_iterator& b) { return std::get<0>(a.m_ptrs) == std::get<0>(b.m_ptrs); }
+    friend bool operator!=(const soa_iterator& a, const soa_iterator& b) { return !(a == b); }
+    friend bool operator<(const soa_iterator& a, const soa_iterator& b) { return std::get<0>(a.m_ptrs) < std::get<0>(b.m_ptrs); }
+
+    std::tuple<Ts*...> m_ptrs;
+};
+
+// Destroys the fields of a row constructed so far, when a later one throws
+template<class Layout>
+struct RowGuard
+{
+    ~RowGuard()
+    {
+        if (m_layout)
+            destroyFields(std::make_index_sequence<std::tuple_size_v<Layout>>{});
+    }
+
+    template<std::size_t... I>
+    void destroyFields(std::index_sequence<I...>)
+    {
+        forEachReversed(std::make_tuple(std::integral_constant<std::size_t, I>{}...), [&] (auto i) {
+            constexpr auto f = decltype(i)::value;
+            if (f < m_done)
+                reverse_destroy(std::get<f>(*m_layout).begin() + m_row, std::get<f>(*m_layout).begin() + m_row + 1);
+        }, std::index_sequence<I...>{});
+    }
+
+    void release() { m_layout = nullptr; }
+    const Layout* m_layout;
+    std::size_t m_row;
+    std::size_t m_done {0};
+};
+
+// Structure of arrays: every field is stored in its own column, all the columns share a single block.
+// Growth is geometric, relocating a column copies or moves its elements as std::vector does
+// (std::move_if_noexcept). Fields are plain types or aligned_column<T, N>.
+template<class... Fields>
+struct soa_vector
+{
+    static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+    using Layout = std::tuple<typename ColumnTraits<Fields>::size_type::span_type...>;
+    using Columns = std::tuple<span<typename ColumnTraits<Fields>::type>...>;
+    using iterator = soa_iterator<typename ColumnTraits<Fields>::type...>;
+    using const_iterator = soa_iterator<const typename ColumnTraits<Fields>::type...>;
+    using reference = typename iterator::reference;
+    using const_reference = typename const_iterator::reference;
+    using Indices = std::index_sequence_for<Fields...>;
+
+    static constexpr std::size_t s_blockAlignment = blockAlignment<typename ColumnTraits<Fields>::size_type::span_type...>;
+    static constexpr std::size_t s_minCapacity = 8;
+
+    soa_vector() = default;
+
+    explicit soa_vector(std::size_t count) { resize(count); }
+
+    soa_vector(const soa_vector& other)
+    {
+        if (other.m_size)
+        {
+            auto fresh = allocate(other.m_size);
+            MemGuard<s_blockAlignment> mg{layoutBegin(fresh)};
+            copyColumns(fresh, other, Indices{});
+            mg.release();
+            m_layout = fresh;
+            m_size = m_capacity = other.m_size;
+        }
+    }
+
+    soa_vector(soa_vector&& other) noexcept
+        : m_layout(std::exchange(other.m_layout, Layout{})),
+          m_size(std::exchange(other.m_size, 0)),
+          m_capacity(std::exchange(other.m_capacity, 0)) {}
+
+    soa_vector& operator=(soa_vector other) noexcept
+    {
+        std::swap(m_layout, other.m_layout);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+        return *this;
+    }
+
+    ~soa_vector()
+    {
+        clear();
+        if (m_capacity)
+            deallocateBlock<s_blockAlignment>(layoutBegin(m_layout));
+    }
+
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_capacity; }
+    bool empty() const { return m_size == 0; }
+
+    // Elements of field I, for loops over a single column
+    template<std::size_t I>
+    auto column()
+    {
+        using T = std::tuple_element_t<I, std::tuple<typename ColumnTraits<Fields>::type...>>;
+        T* b = std::get<I>(m_layout).begin();
+        return span<T>{b, b + m_size};
+    }
+
+    template<std::size_t I>
+    auto column() const
+    {
+        using T = const std::tuple_element_t<I, std::tuple<typename ColumnTraits<Fields>::type...>>;
+        T* b = std::get<I>(m_layout).begin();
+        return span<T>{b, b + m_size};
+    }
+
+    iterator begin() { return rowIterator<iterator>(0, Indices{}); }
+    iterator end() { return rowIterator<iterator>(m_size, Indices{}); }
+    const_iterator begin() const { return rowIterator<const_iterator>(0, Indices{}); }
+    const_iterator end() const { return rowIterator<const_iterator>(m_size, Indices{}); }
+
+    reference operator[](std::size_t i) { return begin()[i]; }
+    const_reference operator[](std::size_t i) const { return begin()[i]; }
+
+    // One argument per field, each field is constructed from its own argument
+    template<class... Args>
+    void emplace_back(Args&&... args)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "expected one argument per field");
+
+        if (m_size < m_capacity)
+        {
+            constructRow(m_layout, m_size, Indices{}, std::forward<Args>(args)...);
+        }
+        else
+        {
+            // The row is built in the new block before relocating, the arguments may refer to current elements
+            auto fresh = allocate(nextCapacity(m_size + 1));
+            MemGuard<s_blockAlignment> mg{layoutBegin(fresh)};
+            constructRow(fresh, m_size, Indices{}, std::forward<Args>(args)...);
+            RowGuard<Layout> rg{&fresh, m_size, sizeof...(Fields)};
+            relocate(fresh, Indices{});
+            rg.release();
+            mg.release();
+            adopt(fresh, nextCapacity(m_size + 1));
+        }
+        ++m_size;
+    }
+
+    void push_back(const typename ColumnTraits<Fields>::type&... values) { emplace_back(values...); }
+    void push_back(typename ColumnTraits<Fields>::type&&... values) { emplace_back(std::move(values)...); }
+
+    void pop_back()
+    {
+        --m_size;
+        destroyRows(m_size, m_size + 1);
+    }
+
+    void clear()
+    {
+        destroyRows(0, m_size);
+        m_size = 0;
+    }
+
+    void reserve(std::size_t count)
+    {
+        if (count <= m_capacity)
+            return;
+
+        auto fresh = allocate(count);
+        MemGuard<s_blockAlignment> mg{layoutBegin(fresh)};
+        relocate(fresh, Indices{});
+        mg.release();
+        adopt(fresh, count);
+    }
+
+    // New rows are value-initialized
+    void resize(std::size_t count)
+    {
+        if (count <= m_size)
+        {
+            destroyRows(count, m_size);
+            m_size = count;
+            return;
+        }
+
+        if (count > m_capacity)
+            reserve(nextCapacity(count));
+
+        addRows(count, Indices{});
+        m_size = count;
+    }
+
+    void shrink_to_fit()
+    {
+        if (m_size == m_capacity)
+            return;
+
+        if (!m_size)
+        {
+            deallocateBlock<s_blockAlignment>(layoutBegin(m_layout));
+            m_layout = Layout{};
+            m_capacity = 0;
+            return;
+        }
+
+        auto fresh = allocate(m_size);
+        MemGuard<s_blockAlignment> mg{layoutBegin(fresh)};
+        relocate(fresh, Indices{});
+        mg.release();
+        adopt(fresh, m_size);
+    }
+
+    std::size_t nextCapacity(std::size_t required) const
+    {
+        return std::max({required, 2*m_capacity, s_minCapacity});
+    }
+
+    static Layout allocate(std::size_t capacity)
+    {
+        return makeLayout(PackedOrder::order<typename ColumnTraits<Fields>::size_type::span_type...>(),
+                          typename ColumnTraits<Fields>::size_type(capacity)...);
+    }
+
+    template<class It, std::size_t... I>
+    It rowIterator(std::size_t row, std::index_sequence<I...>) const
+    {
+        return It{{(std::get<I>(m_layout).begin() ? std::get<I>(m_layout).begin() + row : nullptr)...}};
+    }
+
+    template<std::size_t... I>
+    Columns rows(const Layout& layout, std::size_t b, std::size_t e, std::index_sequence<I...>) const
+    {
+        return Columns{{std::get<I>(layout).begin() + b, std::get<I>(layout).begin() + e}...};
+    }
+
+    void destroyRows(std::size_t b, std::size_t e)
+    {
+        if (b == e)
+            return;
+        auto r = rows(m_layout, b, e, Indices{});
+        forEachReversed(r, [] (auto& rng) { reverse_destroy(rng.begin(), rng.end()); }, Indices{});
+    }
+
+    template<std::size_t... I>
+    void addRows(std::size_t count, std::index_sequence<I...>)
+    {
+        auto added = rows(m_layout, m_size, count, Indices{});
+        initRanges(added, arg(std::get<I>(added).size())...);
+    }
+
+    template<std::size_t... I, class... Args>
+    static void constructRow(const Layout& layout, std::size_t row, std::index_sequence<I...>, Args&&... args)
+    {
+        RowGuard<Layout> g{&layout, row};
+        ((new (std::get<I>(layout).begin() + row) typename ColumnTraits<Fields>::type(std::forward<Args>(args)), ++g.m_done), ...);
+        g.release();
+    }
+
+    template<std::size_t... I>
+    void copyColumns(const Layout& fresh, const soa_vector& other, std::index_sequence<I...>)
+    {
+        auto copied = rows(fresh, 0, other.m_size, Indices{});
+        initRanges(copied, arg(input_iterator, other.m_size, (const typename ColumnTraits<Fields>::type*)std::get<I>(other.m_layout).begin())...);
+    }
+
+    // Same relocation as resize_contiguous_objects: the columns that are copied first, then the ones
+    // moved without throwing, so the current block is only modified once nothing can fail anymore
+    template<std::size_t... I>
+    void relocate(const Layout& fresh, std::index_sequence<I...>)
+    {
+        Columns copied {{std::get<I>(fresh).begin(),
+            std::get<I>(fresh).begin() + (relocatesByCopy<typename ColumnTraits<Fields>::type> ? m_size : 0)}...};
+        initRanges(copied, relocationArg(std::get<I>(copied).size(), std::get<I>(m_layout).begin())...);
+        NoAllocator na;
+        ObjectsGuard<NoAllocator, Columns> cg{na, &copied};
+
+        Columns moved {{std::get<I>(fresh).begin(),
+            std::get<I>(fresh).begin() + (relocatesByCopy<typename ColumnTraits<Fields>::type> ? 0 : m_size)}...};
+        initRanges(moved, relocationArg(std::get<I>(moved).size(), std::get<I>(m_layout).begin())...);
+        cg.release();
+    }
+
+    // Takes ownership of a block where the current elements were relocated
+    void adopt(const Layout& fresh, std::size_t capacity)
+    {
+        destroyRows(0, m_size);
+        if (m_capacity)
+            deallocateBlock<s_blockAlignment>(layoutBegin(m_layout));
+        m_layout = fresh;
+        m_capacity = capacity;
+    }
+
+    Layout m_layout {};
+    std::size_t m_size {0};
+    std::size_t m_capacity {0};
+};
+
+}
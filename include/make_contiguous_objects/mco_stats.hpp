@@ -0,0 +1,225 @@
+#pragma once
+
+#include "mco.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace xtd
+{
+
+// Placement of every section of a layout, computed without allocating
+template<std::size_t N>
+struct layout_info
+{
+    std::array<std::size_t, N> m_offsets;   // from the start of the block, in declaration order
+    std::array<std::size_t, N> m_padding;   // inserted in front of each section
+    std::size_t m_elementBytes;
+    std::size_t m_paddingBytes;
+    std::size_t m_numBytes;
+    std::size_t m_alignment;
+};
+
+template<std::size_t N>
+constexpr layout_info<N> layoutInfo(const std::array<std::size_t, N>& aligns, const std::array<std::size_t, N>& sizes,
+                                    const std::array<std::size_t, N>& counts, const std::array<std::size_t, N>& order)
+{
+    layout_info<N> r {};
+    r.m_alignment = 1;
+    std::size_t pos = 0;
+    for (std::size_t k = 0; k < N; ++k)
+    {
+        auto i = order[k];
+        auto pad = findDistanceOfNextAlignedPosition(pos, aligns[i]);
+        r.m_padding[i] = pad;
+        r.m_offsets[i] = pos + pad;
+        r.m_elementBytes += sizes[i]*counts[i];
+        r.m_paddingBytes += pad;
+        r.m_alignment = std::max(r.m_alignment, aligns[i]);
+        pos += pad + sizes[i]*counts[i];
+    }
+    r.m_numBytes = pos;
+    return r;
+}
+
+template<std::size_t N>
+constexpr std::array<std::size_t, N> identityOrder()
+{
+    std::array<std::size_t, N> r {};
+    for (std::size_t i = 0; i < N; ++i)
+        r[i] = i;
+    return r;
+}
+
+// Layout make_contiguous_objects<Args...> would produce for the given counts, one per section or one
+// per dynamic section. Usable in constant expressions.
+template<class... Args, class... Counts>
+constexpr auto layout_stats(Counts... counts)
+{
+    return layoutInfo<sizeof...(Args)>({alignof(typename SectionTraits<Args>::type)...}, {sizeof(typename SectionTraits<Args>::type)...},
+                                       resizedCounts<span<typename SectionTraits<Args>::type, SectionTraits<Args>::extent>...>(counts...),
+                                       identityOrder<sizeof...(Args)>());
+}
+
+// Same for make_contiguous_objects_packed, to compare both
+template<class... Args, class... Counts>
+constexpr auto layout_stats_packed(Counts... counts)
+{
+    return layoutInfo<sizeof...(Args)>({alignof(typename SectionTraits<Args>::type)...}, {sizeof(typename SectionTraits<Args>::type)...},
+                                       resizedCounts<span<typename SectionTraits<Args>::type, SectionTraits<Args>::extent>...>(counts...),
+                                       packedOrder<span<typename SectionTraits<Args>::type>...>());
+}
+
+// Totals per layout signature, recorded by the collector below
+struct signature_stats
+{
+    std::string m_signature;
+    std::size_t m_numLayouts {0};
+    std::size_t m_elementBytes {0};
+    std::size_t m_paddingBytes {0};
+    std::size_t m_numConstructions {0};
+    std::chrono::nanoseconds m_constructTime {0};
+    std::size_t m_numDestructions {0};
+    std::chrono::nanoseconds m_destroyTime {0};
+};
+
+struct instrumentation_stats
+{
+    std::size_t m_blockAllocations {0};
+    std::size_t m_blockBytes {0};
+    std::size_t m_liveBlocks {0};
+    std::vector<signature_stats> m_signatures;
+};
+
+inline std::string demangle(const char* name)
+{
+#if __has_include(<cxxabi.h>)
+    int status = 0;
+    if (char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status))
+    {
+        std::string r(demangled);
+        std::free(demangled);
+        return r;
+    }
+#endif
+    return name;
+}
+
+struct StatsCollector
+{
+    static StatsCollector& get()
+    {
+        static StatsCollector collector;
+        return collector;
+    }
+
+    signature_stats& entry(const std::type_info& signature)
+    {
+        auto& e = m_signatures[std::type_index(signature)];
+        if (e.m_signature.empty())
+            e.m_signature = demangle(signature.name());
+        return e;
+    }
+
+    static void onLayout(const std::type_info& signature, std::size_t elementBytes, std::size_t paddingBytes)
+    {
+        auto& c = get();
+        std::lock_guard<std::mutex> lock(c.m_mutex);
+        auto& e = c.entry(signature);
+        ++e.m_numLayouts;
+        e.m_elementBytes += elementBytes;
+        e.m_paddingBytes += paddingBytes;
+    }
+
+    static void onConstruct(const std::type_info& signature, std::chrono::nanoseconds elapsed)
+    {
+        auto& c = get();
+        std::lock_guard<std::mutex> lock(c.m_mutex);
+        auto& e = c.entry(signature);
+        ++e.m_numConstructions;
+        e.m_constructTime += elapsed;
+    }
+
+    static void onDestroy(const std::type_info& signature, std::chrono::nanoseconds elapsed)
+    {
+        auto& c = get();
+        std::lock_guard<std::mutex> lock(c.m_mutex);
+        auto& e = c.entry(signature);
+        ++e.m_numDestructions;
+        e.m_destroyTime += elapsed;
+    }
+
+    static void onBlockAllocate(std::size_t numBytes)
+    {
+        auto& c = get();
+        c.m_blockAllocations.fetch_add(1, std::memory_order_relaxed);
+        c.m_blockBytes.fetch_add(numBytes, std::memory_order_relaxed);
+        c.m_liveBlocks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void onBlockDeallocate()
+    {
+        get().m_liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    std::mutex m_mutex;
+    std::unordered_map<std::type_index, signature_stats> m_signatures;
+    std::atomic<std::size_t> m_blockAllocations {0};
+    std::atomic<std::size_t> m_blockBytes {0};
+    std::atomic<std::size_t> m_liveBlocks {0};
+};
+
+// Installs the collector as the instrumentation hooks. Does nothing unless compiled with MCO_INSTRUMENTATION.
+inline void install_instrumentation_stats()
+{
+#ifdef MCO_INSTRUMENTATION
+    auto& hooks = instrumentation();
+    hooks.m_onLayout = &StatsCollector::onLayout;
+    hooks.m_onConstruct = &StatsCollector::onConstruct;
+    hooks.m_onDestroy = &StatsCollector::onDestroy;
+    hooks.m_onBlockAllocate = &StatsCollector::onBlockAllocate;
+    hooks.m_onBlockDeallocate = &StatsCollector::onBlockDeallocate;
+#endif
+}
+
+// Signatures sorted by decreasing padding, the layouts worth reordering or pooling come first
+inline instrumentation_stats instrumentation_stats_snapshot()
+{
+    auto& c = StatsCollector::get();
+    instrumentation_stats r;
+    r.m_blockAllocations = c.m_blockAllocations.load(std::memory_order_relaxed);
+    r.m_blockBytes = c.m_blockBytes.load(std::memory_order_relaxed);
+    r.m_liveBlocks = c.m_liveBlocks.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(c.m_mutex);
+    for (auto& [type, e] : c.m_signatures)
+        r.m_signatures.push_back(e);
+    std::sort(r.m_signatures.begin(), r.m_signatures.end(), [] (auto& a, auto& b) { return a.m_paddingBytes > b.m_paddingBytes; });
+    return r;
+}
+
+// Live blocks are kept, they are still to be freed
+inline void reset_instrumentation_stats()
+{
+    auto& c = StatsCollector::get();
+    std::lock_guard<std::mutex> lock(c.m_mutex);
+    c.m_signatures.clear();
+    c.m_blockAllocations = 0;
+    c.m_blockBytes = 0;
+}
+
+}
@@ -0,0 +1,78 @@
+#include <catch.hpp>
+#include <mco.hpp>
+
+#include <atomic>
+#include <string>
+
+struct alignas(128) OverAligned
+{
+    char c {'o'};
+};
+
+template<class T>
+bool isAligned(T* p, std::size_t alignment)
+{
+    return (std::uintptr_t)p % alignment == 0;
+}
+
+TEST_CASE( "Alignment - over-aligned types", "[make_contiguous_objects]" )
+{
+    for (int x = 0; x < 16; ++x)
+    for (int y = 0; y < 4; ++y)
+    {
+        auto t = xtd::make_contiguous_objects<char, OverAligned, std::string>(x, y, x);
+        CHECK(isAligned(std::get<1>(t).begin(), 128));
+        CHECK(xtd::get_adjacent_address<OverAligned>(std::get<0>(t).end()) == std::get<1>(t).begin());
+        for (auto& e : std::get<1>(t)) { CHECK(e.c == 'o'); }
+        xtd::destroy_contiguous_objects(t);
+
+        std::allocator<char> alloc;
+        auto u = xtd::make_contiguous_objects<OverAligned, char>(alloc, y, x);
+        CHECK(isAligned(std::get<0>(u).begin(), 128));
+        xtd::destroy_contiguous_objects(alloc, u);
+    }
+}
+
+TEST_CASE( "Alignment - aligned sections", "[make_contiguous_objects]" )
+{
+    for (int x = 0; x < 70; ++x)
+    {
+        auto t = xtd::make_contiguous_objects<char, float, std::string>(
+            x,
+            xtd::arg(xtd::aligned<64>, xtd::ctor, x, 1.5f),
+            xtd::arg(xtd::aligned<32>, 2));
+
+        CHECK(isAligned(std::get<1>(t).begin(), 64));
+        CHECK(isAligned(std::get<2>(t).begin(), 32));
+        CHECK(xtd::get_adjacent_address<float, 64>(std::get<0>(t).end()) == std::get<1>(t).begin());
+        CHECK(xtd::get_adjacent_address<std::string, 32>(std::get<1>(t).end()) == std::get<2>(t).begin());
+        CHECK(std::get<1>(t).end() - std::get<1>(t).begin() == x);
+        for (auto& e : std::get<1>(t)) { CHECK(e == 1.5f); }
+
+        xtd::destroy_contiguous_objects(t);
+    }
+}
+
+TEST_CASE( "Alignment - cache line padding", "[make_contiguous_objects]" )
+{
+    std::allocator<int> alloc;
+    for (int x = 0; x < 40; ++x)
+    {
+        auto t = xtd::make_contiguous_objects<char, std::atomic<int>, char>(
+            alloc,
+            x,
+            xtd::arg(xtd::padded<xtd::cache_line_size>, xtd::ctor, 2, 0),
+            x);
+
+        auto hot = std::get<1>(t);
+        auto line = [] (auto* p) { return (std::uintptr_t)p / xtd::cache_line_size; };
+
+        CHECK(isAligned(hot.begin(), xtd::cache_line_size));
+        CHECK(line(hot.end() - 1) != line(std::get<2>(t).begin()));
+        CHECK(xtd::get_adjacent_address<char, xtd::cache_line_size>(hot.end()) == std::get<2>(t).begin());
+        if (x)
+            CHECK(line(std::get<0>(t).end() - 1) != line(hot.begin()));
+
+        xtd::destroy_contiguous_objects(alloc, t);
+    }
+}
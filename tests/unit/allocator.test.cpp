@@ -0,0 +1,159 @@
+#include <catch.hpp>
+#include <mco.hpp>
+#include <mco_allocators.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Counters
+{
+    int allocations {0};
+    int deallocations {0};
+    int constructions {0};
+    int destructions {0};
+};
+
+template<class T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    CountingAllocator(Counters& c) : m_c(&c) {}
+    template<class U> CountingAllocator(const CountingAllocator<U>& o) : m_c(o.m_c) {}
+
+    T* allocate(std::size_t n) { m_c->allocations++; return std::allocator<T>().allocate(n); }
+    void deallocate(T* p, std::size_t n) { m_c->deallocations++; std::allocator<T>().deallocate(p, n); }
+
+    template<class U, class... A>
+    void construct(U* p, A&&... a) { m_c->constructions++; new (p) U(std::forward<A>(a)...); }
+
+    template<class U>
+    void destroy(U* p) { m_c->destructions++; p->~U(); }
+
+    Counters* m_c;
+};
+
+struct ThrowsOnThird
+{
+    ThrowsOnThird() { if (++s_count == 3) throw 1; }
+    static inline int s_count = 0;
+};
+
+TEST_CASE( "Allocator - construct and destroy through the allocator", "[make_contiguous_objects]" )
+{
+    Counters c;
+    CountingAllocator<int> alloc(c);
+
+    struct Agg { int i; long l; };
+    std::vector<std::string> v(3, "from iterator");
+
+    auto t = xtd::make_contiguous_objects<char, std::string, Agg, std::string, int>(
+        alloc,
+        xtd::arg(xtd::ctor, 5, 'x'),
+        xtd::arg(xtd::input_iterator, 3, v.begin()),
+        xtd::arg(xtd::aggregate, 2, 7, 8l),
+        xtd::arg(xtd::functor, 2, [] { return "this is a very long string to avoid sbo"; }),
+        xtd::arg(xtd::uninit, 4));
+
+    CHECK(c.allocations == 1);
+    CHECK(c.constructions == 5 + 3 + 2 + 2);
+
+    for (auto& e : std::get<0>(t)) { CHECK(e == 'x'); }
+    for (auto& e : std::get<1>(t)) { CHECK(e == "from iterator"); }
+    for (auto& e : std::get<2>(t)) { CHECK(e.i == 7); CHECK(e.l == 8); }
+    for (auto& e : std::get<3>(t)) { CHECK(e == "this is a very long string to avoid sbo"); }
+    CHECK(xtd::get_adjacent_address<std::string>(std::get<0>(t).end()) == std::get<1>(t).begin());
+
+    xtd::destroy_contiguous_objects(alloc, t);
+    CHECK(c.deallocations == 1);
+    CHECK(c.destructions == 5 + 3 + 2 + 2 + 4);
+}
+
+TEST_CASE( "Allocator - rollback on exception", "[make_contiguous_objects]" )
+{
+    Counters c;
+    CountingAllocator<char> alloc(c);
+    ThrowsOnThird::s_count = 0;
+
+    CHECK_THROWS(xtd::make_contiguous_objects<std::string, ThrowsOnThird>(alloc, 4, 5));
+    CHECK(c.allocations == 1);
+    CHECK(c.deallocations == 1);
+    CHECK(c.constructions == 4 + 3); // the third ThrowsOnThird construction was attempted
+    CHECK(c.destructions == 4 + 2);
+}
+
+TEST_CASE( "Allocator - size_t lvalues are not mistaken for allocators", "[make_contiguous_objects]" )
+{
+    std::size_t n = 3;
+    auto t = xtd::make_contiguous_objects<int, long>(n, n);
+    CHECK(std::get<1>(t).end() - std::get<1>(t).begin() == 3);
+    xtd::destroy_contiguous_objects(t);
+}
+
+TEST_CASE( "Allocator - monotonic arena", "[arena_allocator]" )
+{
+    alignas(std::max_align_t) std::byte buffer[256];
+    xtd::monotonic_arena arena(buffer, sizeof(buffer), 1024);
+    xtd::arena_allocator<std::byte> alloc(arena);
+
+    std::vector<std::tuple<xtd::span<char>, xtd::span<long>, xtd::span<std::string>>> layouts;
+    for (int i = 0; i < 50; ++i)
+    {
+        layouts.push_back(xtd::make_contiguous_objects<char, long, std::string>(
+            alloc, i, xtd::arg(xtd::ctor, i, long(i)), xtd::arg(xtd::ctor, 2, "this is a very long string to avoid sbo")));
+        for (auto& e : std::get<1>(layouts.back())) { CHECK(e == i); }
+    }
+
+    CHECK(arena.bytes_used() > 0);
+    for (auto& l : layouts)
+        xtd::destroy_contiguous_objects(alloc, l);
+    arena.release();
+    CHECK(arena.bytes_used() == 0);
+}
+
+TEST_CASE( "Allocator - thread pool", "[thread_pool_allocator]" )
+{
+    // Catch assertions are not thread-safe, so each thread only reports a flag
+    auto work = [] (bool& ok) {
+        xtd::thread_pool_allocator<int> alloc;
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto t = xtd::make_contiguous_objects<int, std::string, double>(
+                alloc, xtd::arg(xtd::ctor, i % 17, i), 2, i % 5);
+            for (auto& e : std::get<0>(t)) { ok = ok && e == i; }
+            xtd::destroy_contiguous_objects(alloc, t);
+        }
+    };
+
+    bool ok0 = true, ok1 = true, ok2 = true;
+    std::thread t1(work, std::ref(ok1)), t2(work, std::ref(ok2));
+    work(ok0);
+    t1.join();
+    t2.join();
+    CHECK(ok0);
+    CHECK(ok1);
+    CHECK(ok2);
+}
+
+TEST_CASE( "Allocator - thread pool during thread teardown", "[thread_pool_allocator]" )
+{
+    // Allocated once the pool of the thread is destroyed, then freed into the cache of this thread
+    xtd::thread_pool_allocator<char> alloc;
+    char* p = nullptr;
+    std::thread t([&] {
+        xtd::thread_pool::local();
+        xtd::thread_pool::s_destroyed() = true;
+        p = alloc.allocate(20);
+    });
+    t.join();
+    alloc.deallocate(p, 20);
+
+    // Served from the cache, the block must hold the whole size class
+    auto q = alloc.allocate(30);
+    CHECK(q == p);
+    std::fill(q, q + xtd::thread_pool::classBytes(xtd::thread_pool::sizeClass(30)), 'x');
+    alloc.deallocate(q, 30);
+}
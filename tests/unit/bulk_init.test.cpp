@@ -0,0 +1,67 @@
+#include <catch.hpp>
+#include <mco.hpp>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+enum class Color { red, green };
+struct Pod { int i; float f; };
+
+using IntVecIt = std::vector<int>::iterator;
+using ConstIntVecIt = std::vector<int>::const_iterator;
+
+static_assert(xtd::BulkInit<int, xtd::InitializerConfiguration<xtd::ctor_t, std::tuple<>>>::value);
+static_assert(xtd::BulkInit<double, xtd::InitializerConfiguration<xtd::ctor_t, std::tuple<int&>>>::value);
+static_assert(xtd::BulkInit<Color*, xtd::InitializerConfiguration<xtd::ctor_t, std::tuple<>>>::value);
+static_assert(!xtd::BulkInit<std::string, xtd::InitializerConfiguration<xtd::ctor_t, std::tuple<>>>::value);
+static_assert(xtd::BulkInit<Pod, xtd::InitializerConfiguration<xtd::input_iterator_t, const Pod*>>::value);
+static_assert(xtd::BulkInit<int, xtd::InitializerConfiguration<xtd::input_iterator_t, IntVecIt>>::value);
+static_assert(xtd::BulkInit<int, xtd::InitializerConfiguration<xtd::input_iterator_t, ConstIntVecIt>>::value);
+static_assert(!xtd::BulkInit<long, xtd::InitializerConfiguration<xtd::input_iterator_t, IntVecIt>>::value);
+static_assert(xtd::BulkInit<Pod, xtd::InitializerConfiguration<xtd::uninit_t, int>>::value);
+
+TEST_CASE( "Bulk init - scalars and contiguous copies", "[make_contiguous_objects]" )
+{
+    std::vector<int> src(1000);
+    std::iota(src.begin(), src.end(), -500);
+    std::vector<Pod> pods(10, Pod{3, 1.5f});
+
+    for (std::size_t n : {0, 1, 7, 1000})
+    {
+        auto t = xtd::make_contiguous_objects<double, int, Color, const char*, int, Pod, std::string>(
+            n,
+            xtd::arg(xtd::ctor, n, 42),
+            xtd::arg(xtd::ctor, n, Color::green),
+            n,
+            xtd::arg(xtd::input_iterator, n, src.cbegin()),
+            xtd::arg(xtd::input_iterator, std::min<std::size_t>(n, 10), pods.data()),
+            xtd::arg(xtd::ctor, 2, "this is a very long string to avoid sbo"));
+
+        for (auto e : std::get<0>(t)) { CHECK(e == 0.0); }
+        for (auto e : std::get<1>(t)) { CHECK(e == 42); }
+        for (auto e : std::get<2>(t)) { CHECK(e == Color::green); }
+        for (auto e : std::get<3>(t)) { CHECK(e == nullptr); }
+        CHECK(std::equal(std::get<4>(t).begin(), std::get<4>(t).end(), src.begin()));
+        for (auto& e : std::get<5>(t)) { CHECK(e.i == 3); CHECK(e.f == 1.5f); }
+
+        xtd::destroy_contiguous_objects(t);
+    }
+}
+
+struct ThrowingCopy
+{
+    ThrowingCopy() = default;
+    ThrowingCopy(const ThrowingCopy&) { throw 1; }
+};
+
+TEST_CASE( "Bulk init - rollback of the other sections", "[make_contiguous_objects]" )
+{
+    std::vector<int> src(16, 5);
+    ThrowingCopy tc;
+    CHECK_THROWS(xtd::make_contiguous_objects<std::string, int, int, ThrowingCopy>(
+        xtd::arg(xtd::ctor, 3, "this is a very long string to avoid sbo"),
+        xtd::arg(xtd::input_iterator, 16, src.begin()),
+        16,
+        xtd::arg(xtd::ctor, 1, tc)));
+}
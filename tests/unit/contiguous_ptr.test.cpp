@@ -0,0 +1,75 @@
+#include <catch.hpp>
+#include <mco.hpp>
+#include <mco_contiguous_ptr.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct Node { int key {0}; };
+
+static_assert(sizeof(xtd::contiguous_ptr<Node[1], long[], std::string[]>) == sizeof(void*));
+static_assert(sizeof(xtd::contiguous_ptr<xtd::same_extent_t, char[], long[]>) == sizeof(void*));
+
+TEST_CASE( "contiguous_ptr - spans recomputed from the header", "[contiguous_ptr]" )
+{
+    for (std::size_t x = 0; x < 20; ++x)
+    for (std::size_t y = 0; y < 20; ++y)
+    {
+        std::vector<std::string> v(y, "this is a very long string to avoid sbo");
+        auto p = xtd::make_contiguous_ptr<Node[1], char[], long[2], std::string[]>(
+            xtd::arg(xtd::aggregate, 1, 42),
+            xtd::arg(xtd::ctor, x, 'c'),
+            2,
+            xtd::arg(xtd::input_iterator, y, v.begin()));
+
+        CHECK(p.section<0>().begin()->key == 42);
+        CHECK(p.size<1>() == x);
+        CHECK(p.size<2>() == 2);
+        CHECK(p.size<3>() == y);
+        for (auto c : p.section<1>()) { CHECK(c == 'c'); }
+        for (auto& s : p.section<3>()) { CHECK(s == v[0]); }
+        CHECK(xtd::get_adjacent_address<long>(p.section<1>().end()) == p.section<2>().begin());
+        CHECK(xtd::get_adjacent_address<std::string>(p.section<2>().end()) == p.section<3>().begin());
+    }
+}
+
+TEST_CASE( "contiguous_ptr - static and shared extents", "[contiguous_ptr]" )
+{
+    auto s = xtd::make_contiguous_ptr<Node[1], int[3]>();
+    CHECK((void*)s.section<0>().begin() == s.get());
+    CHECK((std::byte*)s.section<1>().begin() - s.get() == 4);
+
+    auto p = xtd::make_contiguous_ptr<xtd::same_extent_t, char[], std::string[]>(
+        xtd::arg(xtd::ctor, 5, 'a'), xtd::arg(xtd::ctor, 5, "this is a very long string to avoid sbo"));
+    CHECK(p.size<0>() == 5);
+    CHECK(p.size<1>() == 5);
+    CHECK(std::get<0>(p.layout()).size() == 1);
+    CHECK(*p.section<1>().begin() == "this is a very long string to avoid sbo");
+
+    // Counts that differ are rejected before anything is allocated
+    CHECK_THROWS_AS((xtd::make_contiguous_ptr<xtd::same_extent_t, char[], std::string[]>(
+        2, xtd::arg(xtd::ctor, 50, "this is a very long string to avoid sbo"))), std::length_error);
+}
+
+TEST_CASE( "contiguous_ptr - ownership", "[contiguous_ptr]" )
+{
+    using Ptr = xtd::contiguous_ptr<Node[1], std::string[]>;
+    std::vector<Ptr> children;
+    for (int i = 0; i < 10; ++i)
+        children.push_back(xtd::make_contiguous_ptr<Node[1], std::string[]>(xtd::arg(xtd::aggregate, 1, i), i));
+
+    Ptr moved = std::move(children[3]);
+    CHECK(!children[3]);
+    CHECK(moved.section<0>().begin()->key == 3);
+    CHECK(moved.size<1>() == 3);
+
+    children[4] = std::move(moved);
+    CHECK(children[4].section<0>().begin()->key == 3);
+
+    auto raw = children[5].release();
+    CHECK(!children[5]);
+    Ptr adopted(raw);
+    CHECK(adopted.size<1>() == 5);
+    CHECK(std::get<2>(adopted.layout()).size() == 5);
+}
@@ -0,0 +1,113 @@
+#include <catch.hpp>
+#include <mco_layout_descriptor.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+
+struct alignas(32) Wide
+{
+    float m_lanes[8];
+};
+
+TEST_CASE( "layout_descriptor - same offsets as make_contiguous_objects", "[layout_descriptor]" )
+{
+    xtd::layout_descriptor desc({
+        xtd::make_column_descriptor<char>(3),
+        xtd::make_column_descriptor<double>(5),
+        xtd::make_column_descriptor<std::string>(2),
+        xtd::make_column_descriptor<Wide>(3),
+        xtd::make_column_descriptor<short>(7),
+    });
+
+    auto t = xtd::make_contiguous_objects<char, double, std::string, Wide, short>(3, 5, 2, 3, 7);
+    auto block = xtd::layoutBegin(t);
+    CHECK(desc.offset(1) == std::size_t((std::byte*)std::get<1>(t).begin() - block));
+    CHECK(desc.offset(2) == std::size_t((std::byte*)std::get<2>(t).begin() - block));
+    CHECK(desc.offset(3) == std::size_t((std::byte*)std::get<3>(t).begin() - block));
+    CHECK(desc.offset(4) == std::size_t((std::byte*)std::get<4>(t).begin() - block));
+    CHECK(desc.num_bytes() == xtd::numLayoutBytes(t));
+    CHECK(desc.alignment() == 32);
+
+    // The typed layout seen through the descriptor
+    auto r = xtd::as_runtime_layout(desc, t);
+    CHECK(r.column(2).as<std::string>().size() == 2);
+    CHECK_THROWS_AS(r.column(2).as<int>(), std::bad_cast);
+
+    auto l = xtd::make_contiguous_objects(desc);
+    CHECK((std::uintptr_t)l.column(3).m_begin % 32 == 0);
+    for (auto d : l.column(1).as<double>()) { CHECK(d == 0.0); }
+
+    auto typed = xtd::layout_cast<char, double, std::string, Wide, short>(l);
+    static_assert(std::is_same_v<decltype(typed), decltype(t)>);
+    std::get<2>(typed).begin()[1] = "a string long enough to be allocated on the heap";
+    CHECK_THROWS_AS((xtd::layout_cast<char, double, std::string, Wide>(l)), std::bad_cast);
+
+    // Blocks are interchangeable
+    xtd::destroy_contiguous_objects(typed);
+    xtd::destroy_contiguous_objects(r);
+}
+
+TEST_CASE( "layout_descriptor - columns without a type", "[layout_descriptor]" )
+{
+    // A column learned from a schema: 12 byte records, 4 byte aligned
+    xtd::column_descriptor raw {12, 4, 10, nullptr, nullptr, nullptr};
+    xtd::layout_descriptor desc({xtd::make_column_descriptor<std::int64_t>(xtd::uninit, 10), raw});
+    CHECK(desc.offset(1) == 80);
+
+    auto l = xtd::make_contiguous_objects(desc);
+    struct Record { float m_x, m_y, m_z; };
+    auto records = l.column(1).as<Record>();
+    CHECK(records.size() == 10);
+    records.begin()[9].m_z = 1.f;
+    CHECK_THROWS_AS(l.column(1).as<double>(), std::bad_cast);
+    auto typed = xtd::layout_cast<std::int64_t, Record>(l);
+    CHECK(std::get<1>(typed).begin()[9].m_z == 1.f);
+    xtd::destroy_contiguous_objects(l);
+
+    // A typed layout of less aligned elements would be freed with another ::operator delete
+    xtd::column_descriptor wide {64, 64, 2, nullptr, nullptr, nullptr};
+    xtd::layout_descriptor wideDesc({wide});
+    auto w = xtd::make_contiguous_objects(wideDesc);
+    struct Bytes { char m_bytes[64]; };
+    CHECK(w.column(0).as<Bytes>().size() == 2);
+    CHECK_THROWS_AS(xtd::layout_cast<Bytes>(w), std::bad_cast);
+    xtd::destroy_contiguous_objects(w);
+
+    CHECK_THROWS_AS(xtd::layout_descriptor({{12, 3, 1, nullptr, nullptr, nullptr}}), std::invalid_argument);
+}
+
+struct Counted
+{
+    Counted()
+    {
+        if (++s_constructed == s_throwAt)
+            throw std::runtime_error("Counted");
+        ++s_alive;
+    }
+    ~Counted() { --s_alive; }
+    static inline int s_constructed = 0;
+    static inline int s_throwAt = 0;
+    static inline int s_alive = 0;
+};
+
+TEST_CASE( "layout_descriptor - rollback", "[layout_descriptor]" )
+{
+    xtd::layout_descriptor desc({
+        xtd::make_column_descriptor<Counted>(4),
+        xtd::make_column_descriptor<std::string>(2),
+        xtd::make_column_descriptor<Counted>(4),
+    });
+
+    Counted::s_throwAt = 7;
+    CHECK_THROWS_AS(xtd::make_contiguous_objects(desc), std::runtime_error);
+    CHECK(Counted::s_alive == 0);
+
+    Counted::s_throwAt = 0;
+    auto l = xtd::make_contiguous_objects(desc);
+    CHECK(Counted::s_alive == 8);
+    xtd::destroy_contiguous_objects(l);
+    CHECK(Counted::s_alive == 0);
+}
@@ -0,0 +1,134 @@
+#include <catch.hpp>
+#include <mco_mmap.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+struct Entry { std::uint32_t key; float weight; };
+struct Renamed { std::uint32_t key; float weight; };
+
+template<> struct xtd::section_type_tag<Entry> { static std::uint64_t value() { return xtd::type_tag("Entry"); } };
+template<> struct xtd::section_type_tag<Renamed> { static std::uint64_t value() { return xtd::type_tag("Entry"); } };
+
+// Temporary file removed at the end of the test
+struct TempFile
+{
+    TempFile() { m_fd = ::mkstemp(m_path); }
+    ~TempFile() { ::close(m_fd); ::unlink(m_path); }
+    char m_path[32] = "/tmp/mco_mmap_testXXXXXX";
+    int m_fd;
+};
+
+TEST_CASE( "Mmap - save and map back", "[map_contiguous_objects]" )
+{
+    for (std::uint32_t n : {0u, 1u, 1000u, 100000u})
+    {
+        auto t = xtd::make_contiguous_objects<long[2], char, Entry, double>(
+            xtd::arg(xtd::ctor, 2, 7l), xtd::arg(xtd::ctor, n, 'z'), n, xtd::arg(xtd::aligned<64>, xtd::ctor, 3, 0.5));
+        for (std::uint32_t i = 0; i < n; ++i) { std::get<2>(t).begin()[i] = {i, i*0.25f}; }
+
+        TempFile f;
+        REQUIRE(f.m_fd >= 0);
+        xtd::save_contiguous_objects(f.m_fd, t);
+
+        auto m = xtd::map_contiguous_objects<long[2], char, Entry, double>(f.m_path);
+        static_assert(std::is_same_v<decltype(m), std::tuple<xtd::span<const long, 2>, xtd::span<const char>,
+                                                             xtd::span<const Entry>, xtd::span<const double>>>);
+
+        CHECK(std::get<0>(m).begin()[1] == 7);
+        CHECK(std::get<1>(m).size() == n);
+        for (auto c : std::get<1>(m)) { CHECK(c == 'z'); }
+        for (std::uint32_t i = 0; i < n; ++i) { CHECK(std::get<2>(m).begin()[i].key == i); }
+        CHECK((std::uintptr_t)std::get<3>(m).begin() % 64 == 0);
+        CHECK(std::get<3>(m).begin()[2] == 0.5);
+        CHECK(xtd::numLayoutBytes(m) == xtd::numLayoutBytes(t));
+
+        xtd::unmap_contiguous_objects(m);
+        xtd::destroy_contiguous_objects(t);
+    }
+}
+
+TEST_CASE( "Mmap - validation", "[map_contiguous_objects]" )
+{
+    auto t = xtd::make_contiguous_objects_packed<char, Entry>(xtd::arg(xtd::ctor, 5, 'a'), 64);
+    TempFile f;
+    REQUIRE(f.m_fd >= 0);
+    xtd::save_contiguous_objects(f.m_fd, t);
+    xtd::destroy_contiguous_objects(t);
+
+    auto m = xtd::map_contiguous_objects<char, Entry>(f.m_path);
+    CHECK(std::get<0>(m).begin()[4] == 'a');
+    xtd::unmap_contiguous_objects(m);
+
+    CHECK_THROWS(xtd::map_contiguous_objects<char, long>(f.m_path));
+    CHECK_THROWS(xtd::map_contiguous_objects<char, Entry, int>(f.m_path));
+    CHECK_THROWS(xtd::map_contiguous_objects<char[4], Entry>(f.m_path));
+    CHECK_THROWS(xtd::map_contiguous_objects<char>("/nonexistent/mco"));
+
+    TempFile empty;
+    REQUIRE(empty.m_fd >= 0);
+    try
+    {
+        xtd::map_contiguous_objects<char>(empty.m_path);
+        FAIL("an empty file was mapped");
+    }
+    catch (const std::system_error& e)
+    {
+        CHECK(e.code().value() == EINVAL);
+    }
+
+    // Flip a byte of the data, then of the header
+    auto dataOffset = xtd::fileDataOffset<2>();
+    char c = 'b';
+    REQUIRE(::pwrite(f.m_fd, &c, 1, dataOffset + 1) == 1);
+    CHECK_THROWS(xtd::map_contiguous_objects<char, Entry>(f.m_path));
+    auto skipped = xtd::map_contiguous_objects<char, Entry>(f.m_path, xtd::skip_checksum);
+    CHECK(xtd::layoutBegin(skipped)[1] == std::byte('b'));
+    xtd::unmap_contiguous_objects(skipped);
+
+    REQUIRE(::pwrite(f.m_fd, &c, 1, sizeof(xtd::FileHeader) + 3) == 1);
+    CHECK_THROWS(xtd::map_contiguous_objects<char, Entry>(f.m_path, xtd::skip_checksum));
+}
+
+TEST_CASE( "Mmap - section types", "[map_contiguous_objects]" )
+{
+    auto t = xtd::make_contiguous_objects<int, float, Entry>(xtd::arg(xtd::ctor, 3, 1), xtd::arg(xtd::ctor, 3, 2.0f), 2);
+    TempFile f;
+    REQUIRE(f.m_fd >= 0);
+    xtd::save_contiguous_objects(f.m_fd, t);
+    xtd::destroy_contiguous_objects(t);
+
+    // Same sizes and alignments, in another order
+    CHECK_THROWS_AS((xtd::map_contiguous_objects<float, int, Entry>(f.m_path)), std::runtime_error);
+
+    // A specialization with the same name maps the section as another type
+    auto m = xtd::map_contiguous_objects<int, float, Renamed>(f.m_path);
+    CHECK(std::get<1>(m).begin()[2] == 2.0f);
+    CHECK(std::get<2>(m).size() == 2);
+    xtd::unmap_contiguous_objects(m);
+}
+
+TEST_CASE( "Mmap - padding is stored as zeros", "[map_contiguous_objects]" )
+{
+    // 59 bytes in front of the padded section, 56 after it
+    auto t = xtd::make_contiguous_objects<char, double, int>(
+        xtd::arg(xtd::ctor, 5, 'a'), xtd::arg(xtd::padded<64>, xtd::ctor, 1, 2.0), xtd::arg(xtd::ctor, 1, 3));
+    auto block = xtd::layoutBegin(t);
+    std::fill(block + 5, (std::byte*)std::get<1>(t).begin(), std::byte(0xcd));
+    std::fill((std::byte*)std::get<1>(t).end(), (std::byte*)std::get<2>(t).begin(), std::byte(0xcd));
+
+    TempFile f;
+    REQUIRE(f.m_fd >= 0);
+    xtd::save_contiguous_objects(f.m_fd, t);
+
+    auto m = xtd::map_contiguous_objects<char, double, int>(f.m_path);
+    auto mapped = xtd::layoutBegin(m);
+    for (auto p = mapped + 5; p != (const std::byte*)std::get<1>(m).begin(); ++p) { CHECK(*p == std::byte(0)); }
+    for (auto p = (const std::byte*)std::get<1>(m).end(); p != (const std::byte*)std::get<2>(m).begin(); ++p) { CHECK(*p == std::byte(0)); }
+    CHECK(std::get<1>(m).begin()[0] == 2.0);
+    CHECK(std::get<2>(m).begin()[0] == 3);
+
+    xtd::unmap_contiguous_objects(m);
+    xtd::destroy_contiguous_objects(t);
+}
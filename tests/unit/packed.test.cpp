@@ -0,0 +1,85 @@
+#include <catch.hpp>
+#include <mco.hpp>
+
+#include <string>
+#include <vector>
+
+static_assert(xtd::worst_case_padding<char, long, char, double>() == 14);
+static_assert(xtd::worst_case_packed_padding<char, long, char, double>() == 0);
+static_assert(xtd::worst_case_padding<long, double, int, char>() == 0);
+static_assert(xtd::worst_case_padding<char, short, int>() == 1 + 2);
+
+static std::vector<int> s_log;
+static int s_throwAt = 0;
+
+template<int Tag, class Filler>
+struct Recorder
+{
+    Recorder() { s_log.push_back(Tag); if (s_throwAt == Tag) throw Tag; }
+    ~Recorder() { s_log.push_back(-Tag); }
+    Filler m_filler {};
+};
+
+TEST_CASE( "Packed - smaller block, declaration order tuple", "[make_contiguous_objects_packed]" )
+{
+    auto regular = xtd::make_contiguous_objects<char, long, char, double>(1, 1, 1, 1);
+    auto packed = xtd::make_contiguous_objects_packed<char, long, char, double>(
+        xtd::arg(xtd::ctor, 1, 'a'), xtd::arg(xtd::ctor, 1, 10l), xtd::arg(xtd::ctor, 1, 'b'), xtd::arg(xtd::ctor, 1, 2.5));
+
+    CHECK(xtd::numLayoutBytes(regular) == 32);
+    CHECK(xtd::numLayoutBytes(packed) == 18);
+
+    CHECK(*std::get<0>(packed).begin() == 'a');
+    CHECK(*std::get<1>(packed).begin() == 10);
+    CHECK(*std::get<2>(packed).begin() == 'b');
+    CHECK(*std::get<3>(packed).begin() == 2.5);
+    CHECK((void*)std::get<1>(packed).begin() == xtd::layoutBegin(packed));
+
+    xtd::destroy_contiguous_objects(regular);
+    xtd::destroy_contiguous_objects(packed);
+}
+
+TEST_CASE( "Packed - stress", "[make_contiguous_objects_packed]" )
+{
+    std::allocator<char> alloc;
+    for (int x = 0; x < 20; ++x)
+    for (int y = 0; y < 20; ++y)
+    {
+        auto t = xtd::make_contiguous_objects_packed<char, std::string, short, long>(
+            x, xtd::arg(xtd::ctor, y, "this is a very long string to avoid sbo"), y, x);
+        for (auto& s : std::get<1>(t)) { CHECK(s == "this is a very long string to avoid sbo"); }
+        for (auto& s : std::get<2>(t)) { s = 1; }
+        for (auto& l : std::get<3>(t)) { l = 2; }
+        xtd::destroy_contiguous_objects(t);
+
+        auto u = xtd::make_contiguous_objects_packed<char, std::string, short, long>(alloc, x, y, y, x);
+        CHECK(xtd::numLayoutBytes(u) == y*sizeof(std::string) + x*sizeof(long) + y*sizeof(short) + x);
+        xtd::destroy_contiguous_objects(alloc, u);
+    }
+}
+
+TEST_CASE( "Packed - construction and destruction order", "[make_contiguous_objects_packed]" )
+{
+    using A = Recorder<1, char>;
+    using B = Recorder<2, long>;
+    using C = Recorder<3, char>;
+    s_log.clear();
+
+    auto t = xtd::make_contiguous_objects_packed<A, B, C>(1, 2, 1);
+    CHECK(s_log == std::vector<int>{1, 2, 2, 3});
+
+    xtd::destroy_contiguous_objects(t);
+    CHECK(s_log == std::vector<int>{1, 2, 2, 3, -3, -2, -2, -1});
+}
+
+TEST_CASE( "Packed - rollback", "[make_contiguous_objects_packed]" )
+{
+    using A = Recorder<4, char>;
+    using B = Recorder<5, long>;
+    s_log.clear();
+    s_throwAt = 5;
+
+    CHECK_THROWS(xtd::make_contiguous_objects_packed<A, B>(2, 1));
+    CHECK(s_log == std::vector<int>{4, 4, 5, -4, -4});
+    s_throwAt = 0;
+}
@@ -0,0 +1,72 @@
+#include <catch.hpp>
+#include <mco_parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+struct Counted
+{
+    Counted() { if (++s_made == s_throwAt) throw 1; ++s_live; }
+    ~Counted() { --s_live; s_destroyed.push_back(this); }
+    std::uint64_t m_payload[4] {};
+
+    static inline std::atomic<int> s_made = 0;
+    static inline std::atomic<int> s_live = 0;
+    static inline int s_throwAt = 0;
+    static inline std::vector<const Counted*> s_destroyed; // only written by the thread rolling back
+};
+
+TEST_CASE( "Parallel - large sections", "[make_contiguous_objects]" )
+{
+    const std::size_t n = 1 << 20;
+    std::vector<int> src(n);
+    std::iota(src.begin(), src.end(), 0);
+    std::list<short> seq(100000, 3);
+
+    for (unsigned threads : {1u, 3u, 8u})
+    {
+        auto t = xtd::make_contiguous_objects<char, int, long, std::string, short, double>(
+            xtd::parallel_t{threads},
+            xtd::arg(xtd::ctor, 3, 'c'),
+            xtd::arg(xtd::input_iterator, n, src.begin()),
+            xtd::arg(xtd::functor, n, [] { return 5l; }),
+            xtd::arg(xtd::ctor, 200000, "this is a very long string to avoid sbo"),
+            xtd::arg(xtd::input_iterator, seq.size(), seq.begin()),
+            n);
+
+        CHECK(std::equal(std::get<1>(t).begin(), std::get<1>(t).end(), src.begin()));
+        CHECK(std::all_of(std::get<2>(t).begin(), std::get<2>(t).end(), [] (long l) { return l == 5; }));
+        CHECK(std::all_of(std::get<3>(t).begin(), std::get<3>(t).end(), [] (auto& s) { return s == "this is a very long string to avoid sbo"; }));
+        CHECK(std::all_of(std::get<4>(t).begin(), std::get<4>(t).end(), [] (short s) { return s == 3; }));
+        CHECK(std::all_of(std::get<5>(t).begin(), std::get<5>(t).end(), [] (double d) { return d == 0.0; }));
+        CHECK(xtd::get_adjacent_address<int>(std::get<0>(t).end()) == std::get<1>(t).begin());
+
+        xtd::destroy_contiguous_objects(t);
+    }
+}
+
+TEST_CASE( "Parallel - rollback in reverse order", "[make_contiguous_objects]" )
+{
+    for (int throwAt : {1, 5000, 40000, 99999})
+    {
+        Counted::s_made = 0;
+        Counted::s_throwAt = throwAt;
+        Counted::s_destroyed.clear();
+
+        CHECK_THROWS(xtd::make_contiguous_objects<std::string, Counted>(
+            xtd::parallel_t{4}, xtd::arg(xtd::ctor, 5000, "this is a very long string to avoid sbo"), 100000));
+
+        CHECK(Counted::s_live == 0);
+        CHECK(std::is_sorted(Counted::s_destroyed.rbegin(), Counted::s_destroyed.rend()));
+    }
+    Counted::s_throwAt = 0;
+
+    auto t = xtd::make_contiguous_objects_packed<char, Counted>(xtd::par, 10, 100000);
+    CHECK(Counted::s_live == 100000);
+    xtd::destroy_contiguous_objects(t);
+    CHECK(Counted::s_live == 0);
+}
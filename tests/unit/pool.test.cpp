@@ -0,0 +1,130 @@
+#include <catch.hpp>
+#include <mco_pool.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Header
+{
+    int m_numKeys;
+};
+
+TEST_CASE( "contiguous_object_pool - layouts match make_contiguous_objects", "[pool]" )
+{
+    xtd::contiguous_object_pool<Header[1], short[], double[]> pool(7, 5);
+    CHECK(pool.slot_bytes() == 64); // 4 + 14 bytes, padded to 24, + 40
+
+    auto t = pool.make(xtd::arg(xtd::aggregate, 1, 3), xtd::arg(3), xtd::arg(xtd::ctor, 2, 1.5));
+    auto u = xtd::make_contiguous_objects<Header[1], short[], double[]>(xtd::arg(xtd::aggregate, 1, 3), 3, xtd::arg(xtd::ctor, 2, 1.5));
+    static_assert(std::is_same_v<decltype(t), decltype(u)>);
+
+    auto offset = [] (auto& layout, auto* p) { return (std::byte*)p - (std::byte*)std::get<0>(layout).begin(); };
+    CHECK(offset(t, std::get<1>(t).begin()) == offset(u, std::get<1>(u).begin()));
+    CHECK(offset(t, std::get<2>(t).begin()) == offset(u, std::get<2>(u).begin()));
+    CHECK(std::get<0>(t).begin()->m_numKeys == 3);
+    CHECK(std::get<2>(t).begin()[1] == 1.5);
+
+    // The static section can be left out
+    auto v = pool.make(7, 5);
+    CHECK(std::get<1>(v).size() == 7);
+    CHECK((std::uintptr_t)std::get<2>(v).begin() % alignof(double) == 0);
+
+    CHECK_THROWS_AS(pool.make(8, 0), std::length_error);
+
+    pool.destroy(t);
+    pool.destroy(v);
+    xtd::destroy_contiguous_objects(u);
+}
+
+TEST_CASE( "contiguous_object_pool - slots are reused", "[pool]" )
+{
+    xtd::contiguous_object_pool<Header, std::string[]> pool(xtd::pool_options{16}, 1, 4);
+
+    std::vector<decltype(pool.make(1, 4))> nodes;
+    for (int i = 0; i < 40; ++i)
+        nodes.push_back(pool.make(1, xtd::arg(xtd::ctor, i % 5, "a string long enough to be allocated on the heap")));
+    CHECK(pool.num_slabs() == 3);
+
+    // Instances of a slab are adjacent
+    CHECK((std::byte*)std::get<0>(nodes[1]).begin() - (std::byte*)std::get<0>(nodes[0]).begin() == std::ptrdiff_t(pool.slot_bytes()));
+
+    auto freed = std::get<0>(nodes[10]).begin();
+    pool.destroy(nodes[10]);
+    auto again = pool.make(1, 2);
+    CHECK(std::get<0>(again).begin() == freed);
+    nodes[10] = again;
+
+    for (auto& n : nodes)
+        pool.destroy(n);
+    CHECK(pool.num_slabs() == 3);
+}
+
+struct Throwing
+{
+    Throwing()
+    {
+        if (++s_constructed == s_throwAt)
+            throw std::runtime_error("Throwing");
+        ++s_alive;
+    }
+    ~Throwing() { --s_alive; }
+    static inline int s_constructed = 0;
+    static inline int s_throwAt = 0;
+    static inline int s_alive = 0;
+};
+
+TEST_CASE( "contiguous_object_pool - exception safety", "[pool]" )
+{
+    xtd::contiguous_object_pool<Throwing[], Throwing[]> pool(4, 4);
+
+    Throwing::s_throwAt = 6;
+    CHECK_THROWS_AS(pool.make(4, 4), std::runtime_error);
+    CHECK(Throwing::s_alive == 0);
+
+    // The slot went back to the free list
+    Throwing::s_throwAt = 0;
+    auto t = pool.make(4, 4);
+    auto u = pool.make(1, 1);
+    CHECK((std::byte*)std::get<0>(u).begin() - (std::byte*)std::get<0>(t).begin() == std::ptrdiff_t(pool.slot_bytes()));
+    CHECK(Throwing::s_alive == 10);
+    pool.destroy(t);
+    pool.destroy(u);
+    CHECK(Throwing::s_alive == 0);
+}
+
+TEST_CASE( "contiguous_object_pool - thread caches", "[pool]" )
+{
+    xtd::contiguous_object_pool<Header, long[]> pool(xtd::pool_options{64, 4}, 1, 8);
+
+    // Catch assertions are not thread-safe, so each thread only reports a flag
+    bool ok[4] = {true, true, true, true};
+    std::vector<std::thread> threads;
+    for (int k = 0; k < 4; ++k)
+    {
+        threads.emplace_back([&, k] {
+            std::vector<decltype(pool.make(1, 8))> live;
+            for (int round = 0; round < 50; ++round)
+            {
+                for (long i = 0; i < 20; ++i)
+                    live.push_back(pool.make(1, xtd::arg(xtd::ctor, 8, i + k*1000)));
+                for (auto& n : live)
+                {
+                    auto v = std::get<1>(n).begin()[7];
+                    ok[k] = ok[k] && v >= k*1000 && v < k*1000 + 20;
+                    pool.destroy(n);
+                }
+                live.clear();
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+    for (bool threadOk : ok)
+        CHECK(threadOk);
+
+    // Slots are recycled instead of carving new ones
+    CHECK(pool.num_slabs() <= 8);
+}
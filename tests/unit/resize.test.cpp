@@ -0,0 +1,153 @@
+#include <catch.hpp>
+#include <mco.hpp>
+
+#include <string>
+#include <vector>
+
+template<class T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    CountingAllocator(int& live) : m_live(&live) {}
+    template<class U> CountingAllocator(const CountingAllocator<U>& o) : m_live(o.m_live) {}
+
+    T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+    void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    template<class U, class... A>
+    void construct(U* p, A&&... a) { new (p) U(std::forward<A>(a)...); ++*m_live; }
+
+    template<class U>
+    void destroy(U* p) { --*m_live; p->~U(); }
+
+    int* m_live;
+};
+
+struct Tracked
+{
+    Tracked() { if (s_throwAt && ++s_made == s_throwAt) throw 1; ++s_live; }
+    Tracked(const Tracked& o) : m_value(o.m_value) { if (s_throwAt && ++s_made == s_throwAt) throw 1; ++s_live; }
+    ~Tracked() { --s_live; }
+    std::string m_value {"this is a very long string to avoid sbo"};
+
+    static inline int s_live = 0;
+    static inline int s_made = 0;
+    static inline int s_throwAt = 0;
+};
+
+struct MoveOnly
+{
+    MoveOnly(int v = 0) : m_value(new int(v)) {}
+    MoveOnly(MoveOnly&& o) noexcept : m_value(std::exchange(o.m_value, nullptr)) {}
+    ~MoveOnly() { delete m_value; }
+    int* m_value;
+};
+
+TEST_CASE( "Resize - grow and shrink the tail", "[resize_contiguous_objects]" )
+{
+    auto t = xtd::make_contiguous_objects<long, std::string>(xtd::arg(xtd::ctor, 1, 7l), xtd::arg(xtd::ctor, 2, "kept"));
+
+    for (std::size_t n : {5, 40, 3, 0, 9})
+    {
+        auto before = std::get<1>(t).size();
+        t = xtd::resize_contiguous_objects(t, 1, n);
+
+        CHECK(*std::get<0>(t).begin() == 7);
+        CHECK(std::get<1>(t).size() == n);
+        for (std::size_t i = 0; i < n; ++i)
+            CHECK(std::get<1>(t).begin()[i] == (i < before ? "kept" : ""));
+        for (auto& s : std::get<1>(t)) { if (s.empty()) s = "kept"; }
+    }
+
+    xtd::destroy_contiguous_objects(t);
+}
+
+TEST_CASE( "Resize - the block is reused when the layout fits", "[resize_contiguous_objects]" )
+{
+    auto t = xtd::make_contiguous_objects<int, std::string>(xtd::arg(xtd::ctor, 8, 3), 10);
+    auto block = xtd::layoutBegin(t);
+
+    // Shrinking the last section keeps every offset
+    t = xtd::resize_contiguous_objects(t, 8, 4);
+    CHECK(xtd::layoutBegin(t) == block);
+
+    // Sections that are trivially copyable are shifted inside the block
+    auto u = xtd::make_contiguous_objects<char, int, double>(xtd::arg(xtd::ctor, 9, 'a'), xtd::arg(xtd::ctor, 16, 5), xtd::arg(xtd::ctor, 4, 1.5));
+    block = xtd::layoutBegin(u);
+    u = xtd::resize_contiguous_objects(u, 1, 17, 4);
+    CHECK(xtd::layoutBegin(u) == block);
+    CHECK(*std::get<0>(u).begin() == 'a');
+    for (std::size_t i = 0; i < 17; ++i) { CHECK(std::get<1>(u).begin()[i] == (i < 16 ? 5 : 0)); }
+    for (auto d : std::get<2>(u)) { CHECK(d == 1.5); }
+    CHECK(xtd::get_adjacent_address<double>(std::get<1>(u).end()) == std::get<2>(u).begin());
+
+    xtd::destroy_contiguous_objects(t);
+    xtd::destroy_contiguous_objects(u);
+}
+
+TEST_CASE( "Resize - move-only and non-trivial sections", "[resize_contiguous_objects]" )
+{
+    auto t = xtd::make_contiguous_objects<MoveOnly, std::vector<int>>(3, xtd::arg(xtd::ctor, 2, 4, 1));
+    for (int i = 0; i < 3; ++i) { *std::get<0>(t).begin()[i].m_value = i; }
+
+    t = xtd::resize_contiguous_objects(t, 6, 5);
+
+    for (int i = 0; i < 6; ++i) { CHECK(*std::get<0>(t).begin()[i].m_value == (i < 3 ? i : 0)); }
+    CHECK(std::get<1>(t).begin()[1] == std::vector<int>(4, 1));
+    CHECK(std::get<1>(t).begin()[4].empty());
+
+    xtd::destroy_contiguous_objects(t);
+}
+
+TEST_CASE( "Resize - strong exception safety", "[resize_contiguous_objects]" )
+{
+    Tracked::s_live = 0;
+    auto t = xtd::make_contiguous_objects<int, Tracked>(xtd::arg(xtd::ctor, 3, 42), 4);
+    std::get<1>(t).begin()[3].m_value = "last";
+
+    // Throws while creating the new elements, then while copying the kept ones
+    for (int throwAt : {2, 7})
+    {
+        Tracked::s_made = 0;
+        Tracked::s_throwAt = throwAt;
+        CHECK_THROWS(xtd::resize_contiguous_objects(t, 5, 8));
+        Tracked::s_throwAt = 0;
+
+        CHECK(Tracked::s_live == 4);
+        for (auto i : std::get<0>(t)) { CHECK(i == 42); }
+        CHECK(std::get<1>(t).begin()[3].m_value == "last");
+    }
+
+    t = xtd::resize_contiguous_objects(t, 5, 8);
+    CHECK(Tracked::s_live == 8);
+    CHECK(std::get<1>(t).begin()[3].m_value == "last");
+
+    xtd::destroy_contiguous_objects(t);
+    CHECK(Tracked::s_live == 0);
+}
+
+TEST_CASE( "Resize - allocator, static extents and packed layouts", "[resize_contiguous_objects]" )
+{
+    int live = 0;
+    CountingAllocator<char> alloc(live);
+
+    auto t = xtd::make_contiguous_objects<long[2], std::string, char>(alloc, xtd::arg(xtd::ctor, 2, 9l), 3, 5);
+    CHECK(live == 2 + 3 + 5);
+    for (std::size_t n : {1, 30, 2, 64})
+    {
+        t = xtd::resize_contiguous_objects(alloc, t, n, n);
+        CHECK(live == 2 + 2*int(n));
+        CHECK(std::get<0>(t).begin()[1] == 9);
+        CHECK(std::get<2>(t).size() == n);
+    }
+    xtd::destroy_contiguous_objects(alloc, t);
+    CHECK(live == 0);
+
+    auto u = xtd::make_contiguous_objects_packed<char, double, std::string>(xtd::arg(xtd::ctor, 3, 'p'), 2, 1);
+    u = xtd::resize_contiguous_objects_packed(u, 7, 5, 4);
+    CHECK((void*)std::get<1>(u).begin() == xtd::layoutBegin(u));
+    for (std::size_t i = 0; i < 7; ++i) { CHECK(std::get<0>(u).begin()[i] == (i < 3 ? 'p' : 0)); }
+    CHECK(std::get<2>(u).size() == 4);
+    xtd::destroy_contiguous_objects(u);
+}
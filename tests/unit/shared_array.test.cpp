@@ -1,8 +1,11 @@
 #include <catch.hpp>
 #include <mco.hpp>
+#include <mco_shared_array.hpp>
 
 #include <iostream>
 #include <cstring>
+#include <numeric>
+#include <thread>
 #include <vector>
 #include <string>
 
@@ -66,3 +69,98 @@ TEST_CASE( "SharedArray", "[constructor]" )
     SharedArray<int> sai {10};
     SharedArray<std::string> sas {10};
 }
+
+static_assert(sizeof(xtd::shared_array<std::string>) == sizeof(void*));
+
+struct Live
+{
+    Live() { ++s_count; }
+    Live(int v) : m_value(v) { ++s_count; }
+    Live(const Live& o) : m_value(o.m_value) { ++s_count; }
+    ~Live() { --s_count; }
+    int m_value {0};
+    static inline std::atomic<int> s_count = 0;
+};
+
+TEST_CASE( "shared_array - initializers", "[shared_array]" )
+{
+    auto a = xtd::make_shared_array<int>(5);
+    CHECK(a.size() == 5);
+    for (auto i : a) { CHECK(i == 0); }
+
+    auto s = xtd::make_shared_array<std::string>(xtd::arg(xtd::ctor, 3, "this is a very long string to avoid sbo"));
+    CHECK(s[2] == "this is a very long string to avoid sbo");
+
+    std::vector<long> src(100);
+    std::iota(src.begin(), src.end(), 0);
+    auto c = xtd::make_shared_array<long>(xtd::arg(xtd::input_iterator, src.size(), src.begin()));
+    CHECK(std::equal(c.begin(), c.end(), src.begin()));
+
+    int next = 0;
+    auto f = xtd::make_shared_array<Live>(xtd::arg(xtd::functor, 4, [&] { return Live(next++); }));
+    CHECK(f[3].m_value == 3);
+
+    auto o = xtd::make_shared_array_for_overwrite<double>(1000);
+    CHECK(o.size() == 1000);
+    o[999] = 1.0;
+
+    struct alignas(64) Wide { char c; };
+    auto w = xtd::make_shared_array<Wide>(3);
+    CHECK((std::uintptr_t)w.data() % 64 == 0);
+
+    xtd::shared_array<int> empty;
+    CHECK(!empty);
+    CHECK(empty.size() == 0);
+}
+
+TEST_CASE( "shared_array - strong and weak references", "[shared_array]" )
+{
+    Live::s_count = 0;
+    xtd::weak_array<Live> weak;
+    {
+        auto a = xtd::make_shared_array<Live>(xtd::arg(xtd::ctor, 10, 7));
+        CHECK(Live::s_count == 10);
+        auto b = a;
+        CHECK(a.use_count() == 2);
+        weak = b;
+        auto moved = std::move(b);
+        CHECK(!b);
+        CHECK(a.use_count() == 2);
+
+        auto locked = weak.lock();
+        CHECK(locked[9].m_value == 7);
+        CHECK(a.use_count() == 3);
+    }
+
+    // The elements are gone, the block is kept alive by the weak reference
+    CHECK(Live::s_count == 0);
+    CHECK(weak.expired());
+    CHECK(!weak.lock());
+    weak.reset();
+}
+
+TEST_CASE( "shared_array - concurrent copies", "[shared_array]" )
+{
+    Live::s_count = 0;
+    auto a = xtd::make_shared_array<Live>(xtd::arg(xtd::ctor, 4, 1));
+    xtd::weak_array<Live> weak = a;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([a, weak] {
+            for (int i = 0; i < 10000; ++i)
+            {
+                auto copy = a;
+                auto locked = weak.lock();
+                xtd::weak_array<Live> w2 = locked;
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    CHECK(a.use_count() == 1);
+    a.reset();
+    CHECK(Live::s_count == 0);
+}
@@ -0,0 +1,177 @@
+#include <catch.hpp>
+#include <mco_soa_vector.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+TEST_CASE( "soa_vector - push_back and columns", "[soa_vector]" )
+{
+    xtd::soa_vector<int, std::string, double> v;
+    CHECK(v.empty());
+    CHECK(v.capacity() == 0);
+
+    for (int i = 0; i < 100; ++i)
+        v.push_back(i, std::to_string(i) + " is a string long enough to be allocated", i*0.5);
+
+    CHECK(v.size() == 100);
+    CHECK(v.capacity() >= 100);
+
+    auto ints = v.column<0>();
+    CHECK(ints.size() == 100);
+    CHECK(std::accumulate(ints.begin(), ints.end(), 0) == 4950);
+
+    auto strings = v.column<1>();
+    CHECK(strings.begin()[42] == "42 is a string long enough to be allocated");
+
+    auto [i, s, d] = v[7];
+    CHECK(i == 7);
+    CHECK(s.substr(0, 1) == "7");
+    CHECK(d == 3.5);
+
+    // References into the columns
+    std::get<2>(v[7]) = -1;
+    CHECK(v.column<2>().begin()[7] == -1);
+
+    v.pop_back();
+    CHECK(v.size() == 99);
+    v.clear();
+    CHECK(v.empty());
+}
+
+TEST_CASE( "soa_vector - zip iterator", "[soa_vector]" )
+{
+    xtd::soa_vector<float, long> v(10);
+    for (auto& x : v.column<0>()) { CHECK(x == 0.f); }
+
+    long n = 0;
+    for (auto [x, y] : v)
+    {
+        x = float(n);
+        y = n++;
+    }
+    CHECK(n == 10);
+    CHECK(v.end() - v.begin() == 10);
+
+    const auto& cv = v;
+    for (auto it = cv.begin(); it != cv.end(); ++it)
+        CHECK(std::get<0>(*it) == float(std::get<1>(*it)));
+    static_assert(std::is_same_v<decltype(cv.column<0>()), xtd::span<const float>>);
+    CHECK(cv.column<0>().begin() == v.column<0>().begin());
+}
+
+TEST_CASE( "soa_vector - growth and alignment", "[soa_vector]" )
+{
+    xtd::soa_vector<char, xtd::aligned_column<float, 64>, xtd::aligned_column<double, 32>> v;
+
+    std::size_t reallocations = 0;
+    std::size_t capacity = v.capacity();
+    for (int i = 0; i < 1000; ++i)
+    {
+        v.emplace_back(char(i), float(i), double(i));
+        if (v.capacity() != capacity)
+        {
+            ++reallocations;
+            capacity = v.capacity();
+        }
+        CHECK((std::uintptr_t)v.column<1>().begin() % 64 == 0);
+        CHECK((std::uintptr_t)v.column<2>().begin() % 32 == 0);
+    }
+    CHECK(reallocations <= 8);
+
+    for (int i = 0; i < 1000; ++i)
+        CHECK(v.column<1>().begin()[i] == float(i));
+
+    // Padding after the last element is part of the block
+    auto floats = v.column<1>();
+    CHECK((floats.size()*sizeof(float)) <= ((v.capacity()*sizeof(float) + 63)/64*64));
+
+    v.resize(10);
+    v.shrink_to_fit();
+    CHECK(v.capacity() == 10);
+    CHECK(v.column<2>().begin()[9] == 9.0);
+
+    v.reserve(500);
+    CHECK(v.capacity() == 500);
+    CHECK(v.column<0>().begin()[9] == char(9));
+}
+
+TEST_CASE( "soa_vector - copy and move", "[soa_vector]" )
+{
+    xtd::soa_vector<int, std::string> a;
+    a.push_back(1, "one");
+    a.push_back(2, "two");
+
+    auto b = a;
+    CHECK(b.size() == 2);
+    CHECK(std::get<1>(b[1]) == "two");
+    std::get<1>(b[1]) = "deux";
+    CHECK(std::get<1>(a[1]) == "two");
+
+    auto c = std::move(b);
+    CHECK(b.empty());
+    CHECK(std::get<1>(c[1]) == "deux");
+
+    a = c;
+    CHECK(std::get<1>(a[1]) == "deux");
+
+    // The argument refers to an element relocated by the growth
+    xtd::soa_vector<std::string> d;
+    d.push_back("a string long enough to be allocated on the heap");
+    while (d.size() < d.capacity())
+        d.push_back("x");
+    d.push_back(std::get<0>(d[0]));
+    CHECK(std::get<0>(d[d.size() - 1]) == "a string long enough to be allocated on the heap");
+}
+
+struct Counted
+{
+    Counted(int v = 0) : m_value(v)
+    {
+        if (s_throwAt && s_count + 1 == s_throwAt)
+            throw std::runtime_error("Counted");
+        ++s_count;
+    }
+    Counted(const Counted& o) : Counted(o.m_value) {}
+    ~Counted() { --s_count; }
+
+    int m_value;
+    static inline int s_count = 0;
+    static inline int s_throwAt = 0;
+};
+
+TEST_CASE( "soa_vector - exception safety", "[soa_vector]" )
+{
+    Counted::s_count = 0;
+    {
+        xtd::soa_vector<Counted, Counted> v;
+        for (int i = 0; i < 8; ++i)
+            v.emplace_back(i, i);
+        CHECK(v.size() == v.capacity());
+        CHECK(Counted::s_count == 16);
+
+        // Second field of the new row
+        Counted::s_throwAt = 18;
+        CHECK_THROWS_AS(v.emplace_back(8, 8), std::runtime_error);
+        CHECK(Counted::s_count == 16);
+
+        // Copy of the existing rows during the relocation (Counted can throw when moved)
+        Counted::s_throwAt = 22;
+        CHECK_THROWS_AS(v.emplace_back(8, 8), std::runtime_error);
+        CHECK(Counted::s_count == 16);
+        CHECK(v.size() == 8);
+        CHECK(std::get<1>(v[7]).m_value == 7);
+
+        Counted::s_throwAt = 0;
+        v.emplace_back(8, 8);
+        CHECK(Counted::s_count == 18);
+
+        Counted::s_throwAt = 22; // second column
+        CHECK_THROWS_AS(v.resize(12), std::runtime_error);
+        CHECK(v.size() == 9);
+        CHECK(Counted::s_count == 18);
+        Counted::s_throwAt = 0;
+    }
+    CHECK(Counted::s_count == 0);
+}
@@ -0,0 +1,94 @@
+#include <catch.hpp>
+#include <mco.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct Ctrl { unsigned refCount {1}; unsigned size {0}; };
+struct Meta { long value {-1}; };
+
+static_assert(xtd::static_offset<0, Ctrl[1], Meta[4], char[]>() == 0);
+static_assert(xtd::static_offset<1, Ctrl[1], Meta[4], char[]>() == 8);
+static_assert(xtd::static_offset<2, Ctrl[1], Meta[4], char[]>() == 8 + 4*8);
+static_assert(xtd::static_offset<1, char[3], int[2]>() == 4);
+static_assert(xtd::static_layout_bytes<char[3], int[2], char[1]>() == 13);
+static_assert(sizeof(xtd::span<Meta, 4>) == sizeof(Meta*));
+
+TEST_CASE( "Static extent - fully static layout", "[make_contiguous_objects]" )
+{
+    auto t = xtd::make_contiguous_objects<Ctrl[1], Meta[4]>();
+    static_assert(std::is_same_v<decltype(t), std::tuple<xtd::span<Ctrl, 1>, xtd::span<Meta, 4>>>);
+
+    auto block = std::get<0>(t).begin();
+    CHECK(block->refCount == 1);
+    CHECK(xtd::get_static_section<1, Ctrl[1], Meta[4]>(block).begin() == std::get<1>(t).begin());
+    CHECK(xtd::get_adjacent_address<Meta>(std::get<0>(t).end()) == std::get<1>(t).begin());
+    CHECK(std::get<1>(t).size() == 4);
+    for (auto& m : std::get<1>(t)) { CHECK(m.value == -1); }
+
+    xtd::destroy_contiguous_objects(t);
+
+    // Counts that don't match the extent are rejected before anything is allocated
+    CHECK_THROWS_AS((xtd::make_contiguous_objects<Ctrl[1], Meta[4]>(1, 3)), std::length_error);
+    CHECK_THROWS_AS((xtd::make_contiguous_objects<Ctrl[1], std::string[]>(xtd::arg(xtd::ctor, 2), 3)), std::length_error);
+    auto u = xtd::make_contiguous_objects<Meta[4], char>(5);
+    CHECK_THROWS_AS(xtd::resize_contiguous_objects(u, 3, 5), std::length_error);
+    xtd::destroy_contiguous_objects(u);
+}
+
+TEST_CASE( "Static extent - static prefix and runtime tail", "[make_contiguous_objects]" )
+{
+    std::allocator<char> alloc;
+    for (unsigned n = 0; n < 40; ++n)
+    {
+        auto t = xtd::make_contiguous_objects<Ctrl[1], Meta[4], std::string[]>(
+            xtd::arg(xtd::aggregate, 1, 1u, n),
+            xtd::arg(xtd::aggregate, 4, 3l),
+            xtd::arg(xtd::ctor, n, "this is a very long string to avoid sbo"));
+
+        auto block = std::get<0>(t).begin();
+        CHECK(block->size == n);
+        for (auto& m : std::get<1>(t)) { CHECK(m.value == 3); }
+        CHECK(std::get<2>(t).size() == n);
+        CHECK((std::byte*)std::get<2>(t).begin() - (std::byte*)block == std::ptrdiff_t(xtd::static_offset<2, Ctrl[1], Meta[4], std::string[]>()));
+        xtd::destroy_contiguous_objects(t);
+
+        // Static sections can be left out of the initializers
+        auto u = xtd::make_contiguous_objects<Ctrl[1], int, Meta[2]>(alloc, xtd::arg(xtd::ctor, n, 9));
+        CHECK(std::get<1>(u).size() == n);
+        CHECK(std::get<2>(u).begin()->value == -1);
+        xtd::destroy_contiguous_objects(alloc, u);
+    }
+}
+
+// The handle keeps a single pointer, every section is a constant offset away from it
+template<class T>
+struct SmallVector
+{
+    using Layout = std::tuple<xtd::span<Ctrl, 1>, xtd::span<T>>;
+
+    SmallVector(unsigned sz)
+    {
+        auto t = xtd::make_contiguous_objects<Ctrl[1], T[]>(xtd::arg(xtd::aggregate, 1, 1u, sz), sz);
+        m_ctrl = std::get<0>(t).begin();
+    }
+
+    ~SmallVector() { xtd::destroy_contiguous_objects(getLayout()); }
+
+    T* data() const { return (T*)((std::byte*)m_ctrl + xtd::static_offset<1, Ctrl[1], T[]>()); }
+    Layout getLayout() const { return {{m_ctrl}, {data(), data() + m_ctrl->size}}; }
+
+    Ctrl* m_ctrl;
+};
+
+TEST_CASE( "Static extent - single pointer handle", "[make_contiguous_objects]" )
+{
+    SmallVector<std::string> v(5);
+    auto layout = v.getLayout();
+    CHECK(std::get<1>(layout).size() == 5);
+    for (auto& s : std::get<1>(layout)) { CHECK(s.empty()); }
+
+    SmallVector<long> w(3);
+    CHECK(xtd::get_adjacent_address<long>(w.m_ctrl + 1) == w.data());
+}
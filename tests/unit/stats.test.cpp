@@ -0,0 +1,92 @@
+#ifndef MCO_INSTRUMENTATION
+#define MCO_INSTRUMENTATION
+#endif
+
+#include <catch.hpp>
+#include <mco_pool.hpp>
+#include <mco_stats.hpp>
+
+#include <string>
+
+// 1 + 7 padding + 16 + 2 + 6 padding + 32
+static constexpr auto s_stats = xtd::layout_stats<char, double[], short[1], long[]>(1, 2, 4);
+static_assert(s_stats.m_offsets[1] == 8 && s_stats.m_offsets[2] == 24 && s_stats.m_offsets[3] == 32);
+static_assert(s_stats.m_padding[1] == 7 && s_stats.m_padding[3] == 6);
+static_assert(s_stats.m_elementBytes == 51 && s_stats.m_paddingBytes == 13 && s_stats.m_numBytes == 64);
+static_assert(s_stats.m_alignment == 8);
+
+static constexpr auto s_packed = xtd::layout_stats_packed<char, double[], short[1], long[]>(1, 2, 4);
+static_assert(s_packed.m_paddingBytes == 0 && s_packed.m_numBytes == 51);
+static_assert(s_packed.m_offsets[1] == 0 && s_packed.m_offsets[3] == 16 && s_packed.m_offsets[2] == 48 && s_packed.m_offsets[0] == 50);
+
+TEST_CASE( "layout_stats - same offsets as make_contiguous_objects", "[stats]" )
+{
+    auto t = xtd::make_contiguous_objects<char, double[], short[1], long[]>(1, 2, 4);
+    auto block = xtd::layoutBegin(t);
+    CHECK((std::byte*)std::get<1>(t).begin() - block == std::ptrdiff_t(s_stats.m_offsets[1]));
+    CHECK((std::byte*)std::get<2>(t).begin() - block == std::ptrdiff_t(s_stats.m_offsets[2]));
+    CHECK((std::byte*)std::get<3>(t).begin() - block == std::ptrdiff_t(s_stats.m_offsets[3]));
+    CHECK(xtd::numLayoutBytes(t) == s_stats.m_numBytes);
+    xtd::destroy_contiguous_objects(t);
+}
+
+TEST_CASE( "instrumentation - collector", "[stats]" )
+{
+    xtd::install_instrumentation_stats();
+    xtd::reset_instrumentation_stats();
+    auto live = xtd::instrumentation_stats_snapshot().m_liveBlocks;
+
+    auto t = xtd::make_contiguous_objects<char, double>(1, 2);
+    auto u = xtd::make_contiguous_objects<char, double>(3, 1);
+    auto s = xtd::make_contiguous_objects<std::string>(xtd::arg(xtd::ctor, 100, "a string long enough to be allocated on the heap"));
+
+    auto stats = xtd::instrumentation_stats_snapshot();
+    CHECK(stats.m_blockAllocations == 3);
+    CHECK(stats.m_liveBlocks == live + 3);
+    REQUIRE(stats.m_signatures.size() == 2);
+
+    // Sorted by padding
+    auto& e = stats.m_signatures[0];
+    CHECK(e.m_signature.find("double") != std::string::npos);
+    CHECK(e.m_numLayouts == 2);
+    CHECK(e.m_elementBytes == 1 + 16 + 3 + 8);
+    CHECK(e.m_paddingBytes == 7 + 5);
+    CHECK(e.m_numConstructions == 2);
+    CHECK(stats.m_signatures[1].m_paddingBytes == 0);
+
+    xtd::destroy_contiguous_objects(t);
+    xtd::destroy_contiguous_objects(u);
+    xtd::destroy_contiguous_objects(s);
+
+    stats = xtd::instrumentation_stats_snapshot();
+    CHECK(stats.m_liveBlocks == live);
+    CHECK(stats.m_signatures[1].m_numDestructions == 1);
+    CHECK(stats.m_signatures[1].m_destroyTime.count() > 0);
+
+    xtd::instrumentation() = {};
+}
+
+TEST_CASE( "instrumentation - pool", "[stats]" )
+{
+    xtd::install_instrumentation_stats();
+    xtd::reset_instrumentation_stats();
+    auto live = xtd::instrumentation_stats_snapshot().m_liveBlocks;
+    {
+        xtd::contiguous_object_pool<char, double> pool(1, 4);
+        auto l = pool.make(1, 2);
+
+        auto stats = xtd::instrumentation_stats_snapshot();
+        CHECK(stats.m_blockAllocations == 1); // the slab
+        REQUIRE(stats.m_signatures.size() == 1);
+        CHECK(stats.m_signatures[0].m_numLayouts == 1);
+        CHECK(stats.m_signatures[0].m_elementBytes == 1 + 16);
+        CHECK(stats.m_signatures[0].m_paddingBytes == 7);
+        CHECK(stats.m_signatures[0].m_numConstructions == 1);
+
+        pool.destroy(l);
+        CHECK(xtd::instrumentation_stats_snapshot().m_signatures[0].m_numDestructions == 1);
+    }
+    CHECK(xtd::instrumentation_stats_snapshot().m_liveBlocks == live);
+
+    xtd::instrumentation() = {};
+}